@@ -41,8 +41,10 @@
 
 #include "SAT/Preprocess.hpp"
 #include "SAT/TWLSolver.hpp"
+#include "SAT/MinisatInterfacing.hpp"
 #include "SAT/MinisatInterfacingNewSimp.hpp"
 #include "SAT/BufferedSolver.hpp"
+#include "SAT/RecordingSolver.hpp"
 
 #include "Lib/Environment.hpp"
 #include "Lib/Timer.hpp"
@@ -115,6 +117,10 @@ FiniteModelBuilder::FiniteModelBuilder(Problem& prb, const Options& opt)
   // Record option values
   _startModelSize = opt.fmbStartSize();
   _symmetryRatio = opt.fmbSymmetryRatio();
+  _lazyInstances = opt.fmbLazyInstances();
+  _incremental = opt.fmbIncremental();
+  _guardClauses = false;
+  _guardedClauses = 0;
 
   // Load any symbols removed during preprocessing (and their definitions)
   _deletedFunctions.loadFromMap(prb.getEliminatedFunctions());
@@ -154,11 +160,11 @@ FiniteModelBuilder::~FiniteModelBuilder()
   }
 }
 
-// Do all setting up required for finite model search 
-// Returns false we if we failed to reset, this can happen if offsets overflow 2^32, possible for
-// large signatures and large models. If this a frequent problem then we can go to longs.
-bool FiniteModelBuilder::reset(){
-  CALL("FiniteModelBuilder::reset");
+// Compute the offsets of the SAT variables using _sortCapacities
+// Returns false if the offsets overflow VAR_MAX
+bool FiniteModelBuilder::computeOffsets(unsigned& offsets)
+{
+  CALL("FiniteModelBuilder::computeOffsets");
 
   // Construct the offsets for symbols
   // Each symbol requires size^n) variables where n is the number of spaces for grounding
@@ -172,7 +178,7 @@ bool FiniteModelBuilder::reset(){
   static const unsigned VAR_MAX = MinisatInterfacingNewSimp::VAR_MAX;
 
   // Start from 1 as SAT solver variables are 1-based
-  unsigned offsets=1;
+  offsets=1;
   for(unsigned f=0; f<env.signature->functions();f++){
     if(del_f[f]) continue; 
     f_offsets[f]=offsets;
@@ -183,9 +189,9 @@ bool FiniteModelBuilder::reset(){
     DArray<unsigned> f_signature = _sortedSignature->functionSignatures[f];
     ASS(f_signature.size() == env.signature->functionArity(f)+1);
 
-    unsigned add = _sortModelSizes[f_signature[0]]; 
+    unsigned add = _sortCapacities[f_signature[0]]; 
     for(unsigned i=1;i<f_signature.size();i++){
-      add *= _sortModelSizes[f_signature[i]];
+      add *= _sortCapacities[f_signature[i]];
     }
 
     // Check that we do not overflow
@@ -207,7 +213,7 @@ bool FiniteModelBuilder::reset(){
     ASS(p_signature.size()==env.signature->predicateArity(p));
     unsigned add=1;
     for(unsigned i=0;i<p_signature.size();i++){
-      add *= _sortModelSizes[p_signature[i]];
+      add *= _sortCapacities[p_signature[i]];
     }
 
     // Check for overflow
@@ -224,7 +230,7 @@ bool FiniteModelBuilder::reset(){
   if (_xmass) {
     marker_offsets.ensure(_distinctSortSizes.size());
     for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
-      unsigned add = _distinctSortSizes[i];
+      unsigned add = _distinctSortCapacities[i];
 
       marker_offsets[i] = offsets;
 
@@ -257,12 +263,64 @@ bool FiniteModelBuilder::reset(){
     offsets += add;
   }
 
+  return true;
+}
+
+/**
+ * Set the capacity of each sort, i.e. the number of domain elements
+ * the SAT variables are allocated for. If @b withSlack is true, leave
+ * room for the sorts to grow without a reset of the SAT solver.
+ */
+void FiniteModelBuilder::setCapacities(bool withSlack)
+{
+  CALL("FiniteModelBuilder::setCapacities");
+
+  _distinctSortCapacities.ensure(_distinctSortSizes.size());
+  for(unsigned i=0;i<_distinctSortSizes.size();i++){
+    unsigned size = _distinctSortSizes[i];
+    unsigned cap = size;
+    if(withSlack){
+      cap = max(size,min(_distinctSortMaxs[i],size+size/2+1));
+    }
+    _distinctSortCapacities[i] = cap;
+  }
+  _sortCapacities.ensure(_sortedSignature->sorts);
+  for(unsigned s=0;s<_sortedSignature->sorts;s++){
+    _sortCapacities[s] = _distinctSortCapacities[_sortedSignature->parents[s]];
+  }
+}
+
+// Do all setting up required for finite model search 
+// Returns false we if we failed to reset, this can happen if offsets overflow 2^32, possible for
+// large signatures and large models. If this a frequent problem then we can go to longs.
+bool FiniteModelBuilder::reset(){
+  CALL("FiniteModelBuilder::reset");
+
+  unsigned offsets;
+  setCapacities(_incremental);
+  if(!computeOffsets(offsets)){
+    if(!_incremental){
+      return false;
+    }
+    // no room to grow, allocate just the current sizes
+    setCapacities(false);
+    if(!computeOffsets(offsets)){
+      return false;
+    }
+  }
+
   // Create a new SAT solver
+  // with lazy instances or an incremental solver clauses are added between SAT calls, so no variable may be eliminated
   try{
-    _solver = new MinisatInterfacingNewSimp(_opt,true);
+    if(_lazyInstances || _incremental){
+      _solver = new MinisatInterfacing(_opt,true);
+    }else{
+      _solver = new MinisatInterfacingNewSimp(_opt,true);
+    }
   }catch(Minisat::OutOfMemoryException&){
     MinisatInterfacingNewSimp::reportMinisatOutOfMemory();
   }
+  _solver = RecordingSolver::traceIfRequested(_solver.release(), _opt, "fmb");
 
   /*
   if(_opt.satSolver() != Options::SatSolver::MINISAT){
@@ -293,6 +351,18 @@ bool FiniteModelBuilder::reset(){
   // set the number of SAT variables, this could cause an exception
   _solver->ensureVarCount(offsets-1);
 
+  // the variables from here on are round selectors
+  _selectorsOffset = offsets;
+  if(_incremental){
+    _roundSelector = _solver->newVar();
+  }
+  _retainedClauses = 0;
+  _solverFresh = true;
+  _sortSizesInSolver.ensure(_sortedSignature->sorts);
+  for(unsigned s=0;s<_sortedSignature->sorts;s++){
+    _sortSizesInSolver[s] = 0;
+  }
+
   // needs to be redone for each size as we use this to pick the number of
   // things to order and the constants to ground with 
   createSymmetryOrdering();
@@ -300,6 +370,35 @@ bool FiniteModelBuilder::reset(){
   return true;
 }
 
+// Move to the next sizes keeping the SAT solver and the clauses in it
+// Returns false if the sizes do not fit the solver and reset() is needed
+bool FiniteModelBuilder::extend()
+{
+  CALL("FiniteModelBuilder::extend");
+  ASS(_incremental);
+
+  for(unsigned i=0;i<_distinctSortSizes.size();i++){
+    if(_distinctSortSizes[i] > _distinctSortCapacities[i]){
+      return false;
+    }
+  }
+  // instances in the solver must remain instances at the new sizes
+  for(unsigned s=0;s<_sortedSignature->sorts;s++){
+    if(_sortModelSizes[s] < _sortSizesInSolver[s]){
+      return false;
+    }
+  }
+
+  // retire the totality and symmetry clauses of the previous sizes
+  addSATClause(SATLiteral(_roundSelector,0));
+  _roundSelector = _solver->newVar();
+  env.statistics->fmbIncrementalRounds++;
+
+  createSymmetryOrdering();
+
+  return true;
+}
+
 // Compare function symbols by their usage in the problem
 struct FMBSymmetryFunctionComparator
 {
@@ -920,6 +1019,8 @@ void FiniteModelBuilder::addGroundClauses()
 
   // If we don't have any ground clauses don't do anything
   if(!_groundClauses) return;
+  // They do not depend on the sizes, so an extended solver has them already
+  if(!_solverFresh) return;
 
   ClauseList::Iterator cit(_groundClauses);
 
@@ -969,7 +1070,7 @@ unsigned FiniteModelBuilder::estimateInstanceCount()
   return res;
 }
 
-void FiniteModelBuilder::addNewInstances()
+void FiniteModelBuilder::addNewInstances(bool onlyFalseInModel)
 {
   CALL("FiniteModelBuilder::addNewInstances");
 
@@ -1004,10 +1105,14 @@ void FiniteModelBuilder::addNewInstances()
     }
 
     //cout << "maxVarSizes "<<endl;;
+    static DArray<unsigned> inSolverVarSize;
+    inSolverVarSize.ensure(vars);
+
     for(unsigned var=0;var<vars;var++) {
       unsigned srt = (*varSorts)[var];
       //cout << "srt="<<srt;
       maxVarSize[var] = min(_sortModelSizes[srt],_sortedSignature->sortBounds[srt]);
+      inSolverVarSize[var] = min(_sortSizesInSolver[srt],_sortedSignature->sortBounds[srt]);
       //cout << ",max="<<maxVarSize[var] << endl;
 
       if (!_xmass) {
@@ -1024,15 +1129,81 @@ void FiniteModelBuilder::addNewInstances()
     for(unsigned i=0;i<vars;i++) grounding[i]=1;
     grounding[vars-1]=0;
 
+    // Rather than translating every literal of every instance with getSATLiteral,
+    // compute how the SAT variable of each literal depends on each clause variable
+    // (coefs[lindex*vars+var]) and keep the SAT variables (litVars) in step with grounding.
+    // The arithmetic is unsigned, so the initial value below the first grounding may wrap.
+    unsigned clen = c->length();
+    static DArray<unsigned> coefs;
+    static DArray<unsigned> litVars;
+    coefs.ensure(clen*vars);
+    litVars.ensure(clen);
+    for(unsigned lindex=0;lindex<clen;lindex++){
+      Literal* lit = (*c)[lindex];
+      unsigned* litCoefs = coefs.array()+lindex*vars;
+      for(unsigned var=0;var<vars;var++){ litCoefs[var]=0; }
+      if(lit->isTwoVarEquality()){
+        litVars[lindex]=0;
+        continue;
+      }
+      unsigned mult=1;
+      if(lit->isEquality()){
+        ASS(lit->nthArgument(0)->isTerm());
+        ASS(lit->nthArgument(1)->isVar());
+        Term* t = lit->nthArgument(0)->term();
+        unsigned arity = t->arity();
+        const DArray<unsigned>& signature = _sortedSignature->functionSignatures[t->functor()];
+        for(unsigned j=0;j<arity;j++){
+          ASS(t->nthArgument(j)->isVar());
+          litCoefs[t->nthArgument(j)->var()] += mult;
+          mult *= _sortCapacities[signature[j]];
+        }
+        litCoefs[lit->nthArgument(1)->var()] += mult;
+        litVars[lindex] = f_offsets[t->functor()];
+      }else{
+        unsigned arity = lit->arity();
+        const DArray<unsigned>& signature = _sortedSignature->predicateSignatures[lit->functor()];
+        for(unsigned j=0;j<arity;j++){
+          ASS(lit->nthArgument(j)->isVar());
+          litCoefs[lit->nthArgument(j)->var()] += mult;
+          mult *= _sortCapacities[signature[j]];
+        }
+        litVars[lindex] = p_offsets[lit->functor()];
+      }
+      litVars[lindex] -= litCoefs[vars-1];
+    }
+
 instanceLabel:
     for(unsigned var=vars-1;var+1!=0;var--){
      
       //Checking against mins skips instances where sort size restricts it
       if(grounding[var]==maxVarSize[var]){
         grounding[var]=1;
+        for(unsigned lindex=0;lindex<clen;lindex++){
+          litVars[lindex] -= coefs[lindex*vars+var]*(maxVarSize[var]-1);
+        }
       } 
       else{
         grounding[var]++;
+        for(unsigned lindex=0;lindex<clen;lindex++){
+          litVars[lindex] += coefs[lindex*vars+var];
+        }
+
+        // Skip instances the solver has from smaller sizes
+        // (when lazy, those not added yet may still be false)
+        if(!onlyFalseInModel){
+          bool inSolver = true;
+          for(unsigned v=0;v<vars;v++){
+            if(grounding[v] > inSolverVarSize[v]){
+              inSolver = false;
+              break;
+            }
+          }
+          if(inSolver){
+            goto instanceLabel;
+          }
+        }
+
         // Grounding represents a new instance
         static SATLiteralStack satClauseLits;
         satClauseLits.reset();
@@ -1080,7 +1251,7 @@ instanceLabel:
         }
 
         // Ground and translate each literal into a SATLiteral
-        for(unsigned lindex=0;lindex<c->length();lindex++){
+        for(unsigned lindex=0;lindex<clen;lindex++){
           Literal* lit = (*c)[lindex];
 
           // check cases where literal is x=y
@@ -1095,34 +1266,14 @@ instanceLabel:
               continue;
             }
           }
-          if(lit->isEquality()){
-            ASS(lit->nthArgument(0)->isTerm());
-            ASS(lit->nthArgument(1)->isVar());
-            Term* t = lit->nthArgument(0)->term();
-            unsigned functor = t->functor();
-            unsigned arity = t->arity();
-            static DArray<unsigned> use;
-            use.ensure(arity+1);
-
-            for(unsigned j=0;j<arity;j++){
-              ASS(t->nthArgument(j)->isVar());
-              use[j] = grounding[t->nthArgument(j)->var()];
-            }
-            use[arity]=grounding[lit->nthArgument(1)->var()];
-            satClauseLits.push(getSATLiteral(functor,use,lit->polarity(),true));
-            
-          }else{
-            unsigned functor = lit->functor();
-            unsigned arity = lit->arity();
-            static DArray<unsigned> use;
-            use.ensure(arity);
-
-            for(unsigned j=0;j<arity;j++){
-              ASS(lit->nthArgument(j)->isVar());
-              use[j] = grounding[lit->nthArgument(j)->var()];
-            }
-            satClauseLits.push(getSATLiteral(functor,use,lit->polarity(),false));
+          satClauseLits.push(SATLiteral(litVars[lindex],lit->polarity()));
+        }
+
+        if(onlyFalseInModel){
+          if(!isFalseInModel(satClauseLits)){
+            goto instanceLabel;
           }
+          env.statistics->fmbLazyInstances++;
         }
      
         SATClause* satCl = SATClause::fromStack(satClauseLits);
@@ -1134,6 +1285,18 @@ instanceLabel:
   }
 }
 
+bool FiniteModelBuilder::isFalseInModel(const SATLiteralStack& lits)
+{
+  CALL("FiniteModelBuilder::isFalseInModel");
+
+  for(unsigned i=0;i<lits.size();i++){
+    if(_solver->trueInAssignment(lits[i])){
+      return false;
+    }
+  }
+  return true;
+}
+
 // uses _distinctSortSizes to estimate how many instances would we generate
 unsigned FiniteModelBuilder::estimateFunctionalDefCount()
 {
@@ -1183,16 +1346,22 @@ void FiniteModelBuilder::addNewFunctionalDefs()
     const DArray<unsigned>& f_signature = _sortedSignature->functionSignatures[f];
     static DArray<unsigned> maxVarSize;
     maxVarSize.ensure(arity+2);
+    // the sizes for which the solver already has the constraints
+    static DArray<unsigned> inSolverVarSize;
+    inSolverVarSize.ensure(arity+2);
 
     // find max size of y and z 
     unsigned returnSrt = f_signature[arity];
     maxVarSize[0] = min(_sortedSignature->sortBounds[returnSrt],_sortModelSizes[returnSrt]);
     maxVarSize[1] = min(_sortedSignature->sortBounds[returnSrt],_sortModelSizes[returnSrt]);
+    inSolverVarSize[0] = min(_sortedSignature->sortBounds[returnSrt],_sortSizesInSolver[returnSrt]);
+    inSolverVarSize[1] = inSolverVarSize[0];
 
     // we skip 0 and 1 as these are y and z
     for(unsigned var=2;var<arity+2;var++){
       unsigned srt = f_signature[var-2]; // f_signature[arity] is return sort
       maxVarSize[var] = min(_sortedSignature->sortBounds[srt],_sortModelSizes[srt]);
+      inSolverVarSize[var] = min(_sortedSignature->sortBounds[srt],_sortSizesInSolver[srt]);
     }
 
     static DArray<unsigned> grounding;
@@ -1217,6 +1386,18 @@ newFuncLabel:
             //Skip this instance
             goto newFuncLabel;
           }
+          {
+            bool inSolver = true;
+            for(unsigned v=0;v<arity+2;v++){
+              if(grounding[v] > inSolverVarSize[v]){
+                inSolver = false;
+                break;
+              }
+            }
+            if(inSolver){
+              goto newFuncLabel;
+            }
+          }
           static SATLiteralStack satClauseLits;
           satClauseLits.reset();
 
@@ -1506,7 +1687,7 @@ SATLiteral FiniteModelBuilder::getSATLiteral(unsigned f, const DArray<unsigned>&
     var += mult*(grounding[i]-1);
     unsigned srt = signature[i];
     //cout << var << ", " << mult << "," << _sortModelSizes[srt] << endl;
-    mult *= _sortModelSizes[srt];
+    mult *= _sortCapacities[srt];
   }
   //cout << "return " << var << endl;
 
@@ -1518,6 +1699,18 @@ void FiniteModelBuilder::addSATClause(SATClause* cl)
   CALL("FiniteModelBuilder::addSATClause");
   cl = Preprocess::removeDuplicateLiterals(cl);
   if(!cl){ return; }
+  if(_guardClauses){
+    // the clause only holds for the current sizes
+    static SATLiteralStack satClauseLits;
+    satClauseLits.reset();
+    for(unsigned i=0;i<cl->length();i++){
+      satClauseLits.push((*cl)[i]);
+    }
+    satClauseLits.push(SATLiteral(_roundSelector,0));
+    cl->destroy();
+    cl = SATClause::fromStack(satClauseLits);
+    _guardedClauses++;
+  }
 #if VTRACE_FMB
   cout << "ADDING " << cl->toString() << endl; // " of size " << cl->length() << endl;
 #endif
@@ -1597,14 +1790,18 @@ MainLoopResult FiniteModelBuilder::runImpl()
     cout << "GROUND" << endl;
 #endif
     addGroundClauses();
+    if(!_lazyInstances){
 #if VTRACE_FMB
-    cout << "INSTANCES" << endl;
+      cout << "INSTANCES" << endl;
 #endif
-    addNewInstances();
+      addNewInstances(false);
+    }
 #if VTRACE_FMB
     cout << "FUNC DEFS" << endl;
 #endif
     addNewFunctionalDefs();
+    // an extended solver keeps these only for the current sizes
+    _guardClauses = _incremental;
 #if VTRACE_FMB
     cout << "SYM DEFS" << endl;
 #endif
@@ -1614,7 +1811,12 @@ MainLoopResult FiniteModelBuilder::runImpl()
     cout << "TOTAL DEFS" << endl;
 #endif
     addNewTotalityDefs();
+    _guardClauses = false;
 
+    for(unsigned s=0;s<_sortedSignature->sorts;s++){
+      _sortSizesInSolver[s] = _sortModelSizes[s];
+    }
+    _solverFresh = false;
     }
 
 #if VTRACE_FMB
@@ -1628,28 +1830,59 @@ MainLoopResult FiniteModelBuilder::runImpl()
     }
 
     SATSolver::Status satResult = SATSolver::UNKNOWN;
-    {
-      env.statistics->phase = Statistics::FMB_SOLVING;
-      TimeCounter tc(TC_FMB_SAT_SOLVING);
+    // the clauses below this index have been passed to the solver
+    unsigned addedToSolver = _clausesToBeAdded.size();
+    while(true){
+      {
+        env.statistics->phase = Statistics::FMB_SOLVING;
+        TimeCounter tc(TC_FMB_SAT_SOLVING);
 
-      static SATLiteralStack assumptions(_distinctSortSizes.size());
-      assumptions.reset();
-      if (_xmass) {
-        for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
-          assumptions.push(SATLiteral(marker_offsets[i]+_distinctSortSizes[i]-1,0));
-          // cout << "assuming sort " << i << " value " << _distinctSortSizes[i]-1 << " negative" << endl;
-        }
-      } else {
-        for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
-          assumptions.push(SATLiteral(totalityMarker_offset+i,1));
+        static SATLiteralStack assumptions(_distinctSortSizes.size());
+        assumptions.reset();
+        if (_xmass) {
+          for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
+            assumptions.push(SATLiteral(marker_offsets[i]+_distinctSortSizes[i]-1,0));
+            // cout << "assuming sort " << i << " value " << _distinctSortSizes[i]-1 << " negative" << endl;
+          }
+        } else {
+          for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
+            assumptions.push(SATLiteral(totalityMarker_offset+i,1));
+          }
+          for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
+            assumptions.push(SATLiteral(instancesMarker_offset+i,1));
+          }
         }
-        for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
-          assumptions.push(SATLiteral(instancesMarker_offset+i,1));
+        if (_incremental) {
+          assumptions.push(SATLiteral(_roundSelector,1));
         }
+
+        satResult = _solver->solveUnderAssumptions(assumptions);
+        env.statistics->phase = Statistics::FMB_CONSTRAINT_GEN;
+      }
+
+      if(!_lazyInstances || satResult != SATSolver::SATISFIABLE){
+        break;
       }
 
-      satResult = _solver->solveUnderAssumptions(assumptions);
-      env.statistics->phase = Statistics::FMB_CONSTRAINT_GEN;
+      // check the model against all instances and add those it violates
+      {
+        TimeCounter tc(TC_FMB_CONSTRAINT_CREATION);
+        addNewInstances(true);
+      }
+      if(_clausesToBeAdded.size()==addedToSolver){
+        break;
+      }
+      env.statistics->fmbLazyRefinements++;
+
+      Timer::syncClock();
+      if(env.timeLimitReached()){ return MainLoopResult(Statistics::TIME_LIMIT); }
+
+      {
+        TimeCounter tc(TC_FMB_SAT_SOLVING);
+        for(;addedToSolver<_clausesToBeAdded.size();addedToSolver++){
+          _solver->addClause(_clausesToBeAdded[addedToSolver]);
+        }
+      }
     }
 
     // if the clauses are satisfiable then we have found a finite model
@@ -1661,7 +1894,9 @@ MainLoopResult FiniteModelBuilder::runImpl()
     static unsigned numberOfSatCalls = 0;
     numberOfSatCalls++;
     unsigned clauseSetSize = _clausesToBeAdded.size();
-    unsigned weight = clauseSetSize;
+    unsigned weight = _retainedClauses + clauseSetSize;
+    _retainedClauses += clauseSetSize - _guardedClauses;
+    _guardedClauses = 0;
 
     // destroy the clauses
     SATClauseStack::Iterator it(_clausesToBeAdded);
@@ -1673,7 +1908,9 @@ MainLoopResult FiniteModelBuilder::runImpl()
 
     {
       // _solver->explicitlyMinimizedFailedAssumptions(false,true); // TODO: try adding this in
-      const SATLiteralStack& failed = _solver->failedAssumptions();
+      // the core of the solver used with lazy instances or incrementally is not minimal enough for a precise nogood
+      const SATLiteralStack& failed = (_lazyInstances || _incremental) ?
+          _solver->explicitlyMinimizedFailedAssumptions(false,false) : _solver->failedAssumptions();
 
       if (_xmass) {
         unsigned domToGrow = UINT_MAX;
@@ -1684,6 +1921,9 @@ MainLoopResult FiniteModelBuilder::runImpl()
 
         for (unsigned i = 0; i < failed.size(); i++) {
           unsigned var = failed[i].var();
+          if (var >= _selectorsOffset) {
+            continue;
+          }
 
           unsigned srt = which_sort(var);
 
@@ -1765,6 +2005,9 @@ MainLoopResult FiniteModelBuilder::runImpl()
         for (unsigned i = 0; i < failed.size(); i++) {
           unsigned var = failed[i].var();
           ASS_GE(var,totalityMarker_offset);
+          if (var >= _selectorsOffset) {
+            continue;
+          }
 
           if (var < instancesMarker_offset) { // totality used (-> instances used as well / unless the sort is monotonic)
             unsigned dsort = var-totalityMarker_offset;
@@ -1806,6 +2049,9 @@ MainLoopResult FiniteModelBuilder::runImpl()
       }
     }
 
+    if(_incremental && extend()){
+      continue;
+    }
     if(!reset()){
       break;
     }
@@ -87,7 +87,10 @@ private:
   // Adds constraints from ground clauses (same constraints for each model size)
   void addGroundClauses();
   // Adds constraints from grounding the non-ground clauses
-  void addNewInstances();
+  // if onlyFalseInModel is set, only instances false in the current SAT model are added
+  void addNewInstances(bool onlyFalseInModel);
+  // true if every literal is false in the current SAT model
+  bool isFalseInModel(const SATLiteralStack& lits);
 
   // uses _distinctSortSizes to estimate how many instances would we generate
   unsigned estimateInstanceCount();
@@ -132,6 +135,11 @@ private:
 
   // resets all structures and SAT solver using _sortModelSizes 
   bool reset();
+  // moves to the current _sortModelSizes keeping the SAT solver
+  bool extend();
+  // computes f_offsets, p_offsets and the marker offsets from _sortCapacities
+  bool computeOffsets(unsigned& offsets);
+  void setCapacities(bool withSlack);
 
   // make the symmetry orderings
   void createSymmetryOrdering();
@@ -164,6 +172,22 @@ private:
   // SAT clauses to be added. We record them so we can delete them after calling the SAT solver
   SATClauseStack _clausesToBeAdded;
 
+  // When incremental, the solver is kept while the sizes grow within _sortCapacities.
+  // Clauses that only hold for the current sizes (totality, symmetry) are guarded
+  // by the round selector, which is assumed in the current round and retired afterwards.
+  bool _incremental;
+  bool _guardClauses;
+  unsigned _guardedClauses;
+  unsigned _roundSelector;
+  // the first SAT variable that is a round selector
+  unsigned _selectorsOffset;
+  // the number of clauses in the solver that are kept from earlier rounds
+  unsigned _retainedClauses;
+  // true if no round has added its clauses to the solver yet
+  bool _solverFresh;
+  // the sizes of each sort for which the solver has the instances
+  DArray<unsigned> _sortSizesInSolver;
+
   // The inferred signature of sorts (see SortInference.hpp)
   SortedSignature* _sortedSignature;
   // clauses of the problem after preprocessing
@@ -230,6 +254,8 @@ private:
   bool _isAppropriate;
   // Option used in symmetry breaking
   float _symmetryRatio;
+  // Add instances lazily, only when the SAT model violates them
+  bool _lazyInstances;
 
   // how often do we pick the next domain to grow by size and how often by weight (= encoding size estimate)
   unsigned _sizeWeightRatio;
@@ -237,6 +263,9 @@ private:
   // sizes to use for each sort
   DArray<unsigned> _sortModelSizes;
   DArray<unsigned> _distinctSortSizes;
+  // the sizes the SAT variables are allocated for, at least the sizes above
+  DArray<unsigned> _sortCapacities;
+  DArray<unsigned> _distinctSortCapacities;
 
   enum ConstraintSign {
     EQ,     // the value has to matched
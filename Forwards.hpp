@@ -277,6 +277,7 @@ class LiteralIndexingStructure;
 class TermIndex;
 class TermIndexingStructure;
 class ClauseSubsumptionIndex;
+class ClauseFeatureIndex;
 class FormulaIndex;
 
 class TermSharing;
@@ -0,0 +1,115 @@
+
+/*
+ * File ClauseFeatureIndex.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file ClauseFeatureIndex.cpp
+ * Implements class ClauseFeatureIndex.
+ */
+
+#include "Lib/Stack.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Term.hpp"
+
+#include "ClauseFeatureIndex.hpp"
+
+namespace Indexing
+{
+
+/**
+ * Return the depth of the literal @b lit, counting the literal
+ * itself as depth one
+ */
+static unsigned literalDepth(Literal* lit)
+{
+  CALL("literalDepth");
+
+  static Stack<pair<Term*,unsigned> > todo;
+  ASS(todo.isEmpty());
+
+  unsigned res=1;
+  todo.push(make_pair(lit,1u));
+  while(todo.isNonEmpty()) {
+    pair<Term*,unsigned> curr=todo.pop();
+    if(curr.second>res) {
+      res=curr.second;
+    }
+    for(TermList* arg=curr.first->args(); arg->isNonEmpty(); arg=arg->next()) {
+      if(arg->isTerm()) {
+	todo.push(make_pair(arg->term(),curr.second+1));
+      }
+    }
+  }
+  return res;
+}
+
+ClauseFeatures::ClauseFeatures(Clause* cl)
+: posLits(0), negLits(0), posSymbols(0), negSymbols(0), depth(0),
+  posPredicates(0), negPredicates(0), functions(0)
+{
+  CALL("ClauseFeatures::ClauseFeatures");
+
+  static Stack<Term*> todo;
+  ASS(todo.isEmpty());
+
+  unsigned clen=cl->length();
+  for(unsigned i=0;i<clen;i++) {
+    Literal* lit=(*cl)[i];
+    unsigned symbols=lit->weight()-lit->vars();
+    unsigned long long predBit=1ull<<(lit->functor()%64);
+    if(lit->isPositive()) {
+      posLits++;
+      posSymbols+=symbols;
+      posPredicates|=predBit;
+    }
+    else {
+      negLits++;
+      negSymbols+=symbols;
+      negPredicates|=predBit;
+    }
+    unsigned ldepth=literalDepth(lit);
+    if(ldepth>depth) {
+      depth=ldepth;
+    }
+
+    todo.push(lit);
+    while(todo.isNonEmpty()) {
+      Term* t=todo.pop();
+      for(TermList* arg=t->args(); arg->isNonEmpty(); arg=arg->next()) {
+	if(arg->isTerm()) {
+	  functions|=1ull<<(arg->term()->functor()%64);
+	  todo.push(arg->term());
+	}
+      }
+    }
+  }
+}
+
+void ClauseFeatureIndex::handleClause(Clause* c, bool adding)
+{
+  CALL("ClauseFeatureIndex::handleClause");
+
+  if(adding) {
+    _features.set(c, ClauseFeatures(c));
+  }
+  else {
+    _features.remove(c);
+  }
+}
+
+}
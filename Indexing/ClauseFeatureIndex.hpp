@@ -0,0 +1,121 @@
+
+/*
+ * File ClauseFeatureIndex.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file ClauseFeatureIndex.hpp
+ * Defines class ClauseFeatureIndex.
+ */
+
+#ifndef __ClauseFeatureIndex__
+#define __ClauseFeatureIndex__
+
+#include "Forwards.hpp"
+
+#include "Lib/DHMap.hpp"
+
+#include "Index.hpp"
+
+namespace Indexing {
+
+using namespace Kernel;
+using namespace Lib;
+
+/**
+ * Features of a clause that cannot decrease when the clause
+ * is instantiated or extended by further literals.
+ *
+ * If a clause C subsumes a clause D, the features of C are
+ * component-wise less or equal (or a subset of) the features of D.
+ * Equality literals are matched modulo symmetry, which does not
+ * change any of the features.
+ */
+struct ClauseFeatures
+{
+  ClauseFeatures()
+  : posLits(0), negLits(0), posSymbols(0), negSymbols(0), depth(0),
+    posPredicates(0), negPredicates(0), functions(0) {}
+  explicit ClauseFeatures(Clause* cl);
+
+  bool maySubsume(const ClauseFeatures& other) const
+  {
+    return posLits<=other.posLits && negLits<=other.negLits &&
+	posSymbols<=other.posSymbols && negSymbols<=other.negSymbols &&
+	depth<=other.depth &&
+	(posPredicates & ~other.posPredicates)==0 &&
+	(negPredicates & ~other.negPredicates)==0 &&
+	(functions & ~other.functions)==0;
+  }
+
+  /** number of positive literals */
+  unsigned posLits;
+  /** number of negative literals */
+  unsigned negLits;
+  /** number of symbol occurrences in positive literals */
+  unsigned posSymbols;
+  /** number of symbol occurrences in negative literals */
+  unsigned negSymbols;
+  /** maximal depth of a literal */
+  unsigned depth;
+  /** predicate symbols of positive literals (hashed to 64 bits) */
+  unsigned long long posPredicates;
+  /** predicate symbols of negative literals (hashed to 64 bits) */
+  unsigned long long negPredicates;
+  /** function symbols (hashed to 64 bits) */
+  unsigned long long functions;
+};
+
+/**
+ * Index keeping features of the clauses in the simplifying container
+ *
+ * The index is used to reject subsumption candidates retrieved from
+ * the literal indexes before the (expensive) multi-literal matching.
+ */
+class ClauseFeatureIndex
+: public Index
+{
+public:
+  CLASS_NAME(ClauseFeatureIndex);
+  USE_ALLOCATOR(ClauseFeatureIndex);
+
+  /**
+   * Return false if @b subsumer certainly does not subsume the clause
+   * with features @b instance. If @b subsumer is not in the index, true is returned.
+   */
+  bool maySubsume(Clause* subsumer, const ClauseFeatures& instance)
+  {
+    ClauseFeatures* f=_features.findPtr(subsumer);
+    return !f || f->maySubsume(instance);
+  }
+  /**
+   * Return false if the clause with features @b subsumer certainly does
+   * not subsume @b instance. If @b instance is not in the index, true is returned.
+   */
+  bool maySubsume(const ClauseFeatures& subsumer, Clause* instance)
+  {
+    ClauseFeatures* f=_features.findPtr(instance);
+    return !f || subsumer.maySubsume(*f);
+  }
+protected:
+  void handleClause(Clause* c, bool adding);
+private:
+  DHMap<Clause*,ClauseFeatures> _features;
+};
+
+};
+
+#endif /* __ClauseFeatureIndex__ */
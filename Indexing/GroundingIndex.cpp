@@ -33,6 +33,7 @@
 #include "SAT/TWLSolver.hpp"
 #include "SAT/MinisatInterfacing.hpp"
 #include "SAT/BufferedSolver.hpp"
+#include "SAT/RecordingSolver.hpp"
 
 #include "Saturation/SaturationAlgorithm.hpp"
 
@@ -57,6 +58,7 @@ GroundingIndex::GroundingIndex(const Options& opt)
     default:
       ASSERTION_VIOLATION_REP(opt.satSolver());
   }
+  _solver = RecordingSolver::traceIfRequested(_solver.release(), opt, "gs");
   
   _grounder = new GlobalSubsumptionGrounder(_solver.ptr());
 }
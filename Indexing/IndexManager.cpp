@@ -29,6 +29,7 @@
 
 #include "AcyclicityIndex.hpp"
 #include "ArithmeticIndex.hpp"
+#include "ClauseFeatureIndex.hpp"
 #include "CodeTreeInterfaces.hpp"
 #include "GroundingIndex.hpp"
 #include "LiteralIndex.hpp"
@@ -228,6 +229,11 @@ Index* IndexManager::create(IndexType t)
     isGenerating = false;
     break;
 
+  case SUBSUMPTION_FEATURE_INDEX:
+    res=new ClauseFeatureIndex();
+    isGenerating = false;
+    break;
+
   case REWRITE_RULE_SUBST_TREE:
     is=new LiteralSubstitutionTree();
     res=new RewriteRuleIndex(is, _alg->getOrdering());
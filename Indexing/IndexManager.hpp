@@ -53,6 +53,7 @@ enum IndexType {
 
   FW_SUBSUMPTION_SUBST_TREE,
   BW_SUBSUMPTION_SUBST_TREE,
+  SUBSUMPTION_FEATURE_INDEX,
 
   REWRITE_RULE_SUBST_TREE,
 
@@ -55,6 +55,13 @@ public:
     return countIteratorElements(getUnifications(lit, complementary, false));
   }
 
+  /**
+   * Return an estimate of the number of unifications of @b lit
+   * that is obtained without retrieving them
+   */
+  virtual size_t getUnificationCountEstimate(Literal* lit, bool complementary)
+  { return getUnificationCount(lit, complementary); }
+
 #if VDEBUG
   virtual vstring toString() { return "<not supported>"; }
   virtual void markTagged() = 0;
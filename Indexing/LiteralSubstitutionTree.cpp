@@ -30,6 +30,8 @@
 #include "Kernel/SortHelper.hpp"
 #include "Kernel/Term.hpp"
 
+#include "Indexing/TermSharing.hpp"
+
 #include "LiteralSubstitutionTree.hpp"
 
 namespace Indexing
@@ -57,6 +59,7 @@ void LiteralSubstitutionTree::handleLiteral(Literal* lit, Clause* cls, bool inse
   CALL("LiteralSubstitutionTree::handleLiteral");
 
   Literal* normLit=Renaming::normalize(lit);
+  recordEntry(lit, getRootNodeIndex(normLit), LeafData(cls, lit), insert);
 
   BindingMap svBindings;
   getBindings(normLit, svBindings);
@@ -72,6 +75,9 @@ SLQueryResultIterator LiteralSubstitutionTree::getUnifications(Literal* lit,
 	  bool complementary, bool retrieveSubstitutions)
 {
   CALL("LiteralSubstitutionTree::getUnifications");
+  if(useGroundEntries(lit, complementary, false)) {
+    return getGroundResultIterator(lit, complementary, retrieveSubstitutions);
+  }
   return getResultIterator<UnificationsIterator>(lit,
 	  complementary, retrieveSubstitutions,false);
 }
@@ -88,6 +94,10 @@ SLQueryResultIterator LiteralSubstitutionTree::getGeneralizations(Literal* lit,
 {
   CALL("LiteralSubstitutionTree::getGeneralizations");
 
+  if(useGroundEntries(lit, complementary, false)) {
+    return getGroundResultIterator(lit, complementary, retrieveSubstitutions);
+  }
+
   SLQueryResultIterator res=
 //  getResultIterator<GeneralizationsIterator>(lit,
     getResultIterator<FastGeneralizationsIterator>(lit,
@@ -111,6 +121,10 @@ SLQueryResultIterator LiteralSubstitutionTree::getInstances(Literal* lit,
     */
   }
 
+  if(useGroundEntries(lit, complementary, true)) {
+    return getGroundResultIterator(lit, complementary, retrieveSubstitutions);
+  }
+
   SLQueryResultIterator res=
 //      getResultIterator<InstancesIterator>(lit,
       getResultIterator<FastInstancesIterator>(lit,
@@ -207,6 +221,17 @@ private:
   ResultSubstitutionSP _subst;
 };
 
+/**
+ * Return the number of entries that may unify with @b lit, i.e. the
+ * entries with the same header as @b lit, or as its complement if
+ * @b complementary is true
+ */
+size_t LiteralSubstitutionTree::getUnificationCountEstimate(Literal* lit, bool complementary)
+{
+  CALL("LiteralSubstitutionTree::getUnificationCountEstimate");
+
+  return _rootEntries[getRootNodeIndex(lit, complementary)];
+}
 
 SLQueryResultIterator LiteralSubstitutionTree::getVariants(Literal* lit,
 	  bool complementary, bool retrieveSubstitutions)
@@ -326,6 +351,43 @@ SLQueryResultIterator LiteralSubstitutionTree::getResultIterator(Literal* lit,
   }
 }
 
+/**
+ * Return true if the retrieval for @b lit can be answered from the ground
+ * entries alone. Commutative literals are left to the tree, as their
+ * retrieval also has to consider the swapped argument order.
+ */
+bool LiteralSubstitutionTree::useGroundEntries(Literal* lit, bool complementary, bool instances)
+{
+  CALL("LiteralSubstitutionTree::useGroundEntries");
+
+  if(lit->commutative()) {
+    return false;
+  }
+  return groundEntriesSuffice(lit, getRootNodeIndex(lit, complementary), instances);
+}
+
+/**
+ * Return iterator over the ground entries equal to @b lit, or to its
+ * complement if @b complementary is true.
+ */
+SLQueryResultIterator LiteralSubstitutionTree::getGroundResultIterator(Literal* lit,
+	  bool complementary, bool retrieveSubstitutions)
+{
+  CALL("LiteralSubstitutionTree::getGroundResultIterator");
+
+  //if the complement is not shared, no entry can be equal to it
+  Literal* key = complementary ? env.sharing->tryGetOpposite(lit) : lit;
+  LDIterator ldit=getGroundEntries(key);
+  if(retrieveSubstitutions) {
+    return pvi(
+	getContextualIterator(
+	    getMappingIterator(ldit, LDToSLQueryResultWithSubstFn()),
+	    UnifyingContext(lit)) );
+  } else {
+    return pvi( getMappingIterator(ldit, LDToSLQueryResultFn()) );
+  }
+}
+
 unsigned LiteralSubstitutionTree::getRootNodeIndex(Literal* t, bool complementary)
 {
   if(complementary) {
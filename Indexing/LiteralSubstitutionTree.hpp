@@ -60,6 +60,8 @@ public:
   SLQueryResultIterator getVariants(Literal* lit,
 	  bool complementary, bool retrieveSubstitutions);
 
+  size_t getUnificationCountEstimate(Literal* lit, bool complementary);
+
 #if VDEBUG
   virtual void markTagged(){ SubstitutionTree::markTagged();}
   vstring toString() {return SubstitutionTree::toString();}
@@ -79,6 +81,10 @@ private:
   SLQueryResultIterator getResultIterator(Literal* lit,
 	  bool complementary, bool retrieveSubstitutions, bool useConstraints);
 
+  bool useGroundEntries(Literal* lit, bool complementary, bool instances);
+  SLQueryResultIterator getGroundResultIterator(Literal* lit,
+	  bool complementary, bool retrieveSubstitutions);
+
   unsigned getRootNodeIndex(Literal* t, bool complementary=false);
 };
 
@@ -21,6 +21,7 @@
  * Implements class ResultSubstitution.
  */
 
+#include "Kernel/Clause.hpp"
 #include "Kernel/RobSubstitution.hpp"
 #include "Kernel/SubstHelper.hpp"
 
@@ -72,6 +73,31 @@ ResultSubstitutionSP ResultSubstitution::fromSubstitution(RobSubstitution* s, in
   return ResultSubstitutionSP(new RSProxy(s, queryBank, resultBank));
 }
 
+/**
+ * Add to @b weight the weight that the literals of @b cl other than @b except
+ * will have after the application of the substitution, without building them.
+ * Return false (and leave @b weight in an unspecified state) if the
+ * implementation cannot easily give the weights.
+ */
+bool ResultSubstitution::addApplicationWeight(Clause* cl, Literal* except, bool result, size_t& weight)
+{
+  CALL("ResultSubstitution::addApplicationWeight");
+
+  unsigned clen = cl->length();
+  for(unsigned i=0;i<clen;i++) {
+    Literal* lit = (*cl)[i];
+    if(lit==except) {
+      continue;
+    }
+    size_t litWeight = getApplicationWeight(lit, result);
+    if(!litWeight) {
+      return false;
+    }
+    weight += litWeight;
+  }
+  return true;
+}
+
 
 /////////////////////////
 // IdentitySubstitution
@@ -85,6 +85,8 @@ public:
     }
   }
 
+  bool addApplicationWeight(Clause* cl, Literal* except, bool result, size_t& weight);
+
   /**
    * Apply substitution to result term that fulfills the condition,
    * that all its variables are bound to some term of the query.
@@ -26,6 +26,7 @@
 #include <utility>
 
 #include "Shell/Options.hpp"
+#include "Shell/Statistics.hpp"
 
 #include "Kernel/Matcher.hpp"
 #include "Kernel/Renaming.hpp"
@@ -61,7 +62,9 @@ using namespace Indexing;
  * @since 16/08/2008 flight Sydney-San Francisco
  */
 SubstitutionTree::SubstitutionTree(int nodes,bool useC)
-  : tag(false), _nextVar(0), _nodes(nodes), _useC(useC)
+  : tag(false), _nextVar(0), _nodes(nodes), _useC(useC),
+    _rootEntries(nodes), _entryCnt(0),
+    _groundIndexing(env.options->groundEntryIndexing()), _nonGroundEntries(nodes)
 {
   CALL("SubstitutionTree::SubstitutionTree");
 
@@ -85,8 +88,104 @@ SubstitutionTree::~SubstitutionTree()
       delete _nodes[i];
     }
   }
+  DHMap<Term*,Leaf*>::Iterator git(_groundEntries);
+  while(git.hasNext()) {
+    delete git.next();
+  }
 } // SubstitutionTree::~SubstitutionTree
 
+/**
+ * Account for the insertion or removal of an entry with term or literal
+ * @b t under the root with index @b rootIndex. The tree itself is updated
+ * by the caller.
+ */
+void SubstitutionTree::recordEntry(Term* t, unsigned rootIndex, LeafData ld, bool insert)
+{
+  CALL("SubstitutionTree::recordEntry");
+
+  if(insert) {
+    _rootEntries[rootIndex]++;
+    _entryCnt++;
+  } else {
+    ASS_G(_rootEntries[rootIndex],0);
+    _rootEntries[rootIndex]--;
+    _entryCnt--;
+  }
+
+  if(!_groundIndexing) {
+    return;
+  }
+  if(!t->shared() || !t->ground()) {
+    if(insert) {
+      _nonGroundEntries[rootIndex]++;
+    } else {
+      ASS_G(_nonGroundEntries[rootIndex],0);
+      _nonGroundEntries[rootIndex]--;
+    }
+    return;
+  }
+
+  Leaf** pleaf;
+  if(insert) {
+    if(_groundEntries.getValuePtr(t,pleaf,0)) {
+      *pleaf=createLeaf();
+    }
+    ensureLeafEfficiency(pleaf);
+    (*pleaf)->insert(ld);
+  } else {
+    ALWAYS(!_groundEntries.getValuePtr(t,pleaf));
+    (*pleaf)->remove(ld);
+    ensureLeafEfficiency(pleaf);
+    if((*pleaf)->isEmpty()) {
+      delete *pleaf;
+      _groundEntries.remove(t);
+    }
+  }
+}
+
+/**
+ * Return true if the results of a retrieval for @b query from the root
+ * with index @b rootIndex are exactly the ground entries equal to @b query.
+ *
+ * This is the case for ground queries when retrieving instances, as the
+ * only instance of a ground term is the term itself, and when retrieving
+ * generalizations or unifications from a root with no non-ground entries.
+ * Empty roots and roots that are leaves are answered without traversal
+ * anyway, so they are left to the tree.
+ */
+bool SubstitutionTree::groundEntriesSuffice(Term* query, unsigned rootIndex, bool instances)
+{
+  CALL("SubstitutionTree::groundEntriesSuffice");
+
+  if(!_groundIndexing || !query->shared() || !query->ground()) {
+    return false;
+  }
+  Node* root=_nodes[rootIndex];
+  if(!root || root->isLeaf()) {
+    return false;
+  }
+  if(instances || !_nonGroundEntries[rootIndex]) {
+    env.statistics->substTreeGroundRetrievals++;
+    return true;
+  }
+  return false;
+}
+
+/**
+ * Return the entries with the ground term or literal @b key, which may
+ * be zero if there can be no such entry.
+ */
+SubstitutionTree::LDIterator SubstitutionTree::getGroundEntries(Term* key)
+{
+  CALL("SubstitutionTree::getGroundEntries");
+
+  Leaf* leaf;
+  if(!key || !_groundEntries.find(key,leaf)) {
+    return LDIterator::getEmpty();
+  }
+  return leaf->allChildren();
+}
+
 /**
  * Store initial bindings of term @b t into @b bq.
  *
@@ -107,6 +206,49 @@ void SubstitutionTree::getBindings(Term* t, BindingMap& svBindings)
   }
 }
 
+/**
+ * Return the set of function symbols occurring in the arguments of @b t
+ */
+SubstitutionTree::SymbolSet SubstitutionTree::argumentSymbols(Term* t)
+{
+  CALL("SubstitutionTree::argumentSymbols");
+
+  static Stack<Term*> toDo;
+  toDo.reset();
+
+  SymbolSet res=0;
+  for(;;) {
+    for(TermList* args=t->args(); !args->isEmpty(); args=args->next()) {
+      if(args->isTerm()) {
+        res|=symbolBit(args->term()->functor());
+        toDo.push(args->term());
+      }
+    }
+    if(toDo.isEmpty()) {
+      return res;
+    }
+    t=toDo.pop();
+  }
+}
+
+/**
+ * Return the set of function symbols occurring in the terms bound in @b svBindings
+ */
+SubstitutionTree::SymbolSet SubstitutionTree::bindingSymbols(BindingMap& svBindings)
+{
+  CALL("SubstitutionTree::bindingSymbols");
+
+  SymbolSet res=0;
+  BindingMap::Iterator bit(svBindings);
+  while(bit.hasNext()) {
+    TermList t=bit.next();
+    if(t.isTerm()) {
+      res|=symbolBit(t.term()->functor()) | argumentSymbols(t.term());
+    }
+  }
+  return res;
+}
+
 struct UnresolvedSplitRecord
 {
   UnresolvedSplitRecord() {}
@@ -158,6 +300,9 @@ void SubstitutionTree::insert(Node** pnode,BindingMap& svBindings,LeafData ld)
   if(tag){cout << "Insert " << ld.toString() << endl;}
 #endif
 
+  //every node on the path to the leaf of the new entry gets its symbols
+  SymbolSet syms=bindingSymbols(svBindings);
+
   if(*pnode == 0) {
     if(svBindings.isEmpty()) {
       *pnode=createLeaf();
@@ -168,6 +313,7 @@ void SubstitutionTree::insert(Node** pnode,BindingMap& svBindings,LeafData ld)
   if(svBindings.isEmpty()) {
     ASS((*pnode)->isLeaf());
     ensureLeafEfficiency(reinterpret_cast<Leaf**>(pnode));
+    (*pnode)->addSymbols(syms);
     static_cast<Leaf*>(*pnode)->insert(ld);
     return;
   }
@@ -230,6 +376,7 @@ start:
 
       Node* node=*pnode;
       IntermediateNode* newNode = createIntermediateNode(node->term, urr.var,_useC);
+      newNode->copySymbols(node);
       node->term=urr.original;
 
       *pnode=newNode;
@@ -244,6 +391,7 @@ start:
 
   IntermediateNode* inode = static_cast<IntermediateNode*>(*pnode);
   ASS(inode);
+  inode->addSymbols(syms);
 
   unsigned boundVar=inode->childVar;
   TermList term=svBindings.get(boundVar);
@@ -266,6 +414,7 @@ start:
     while (!remainingBindings.isEmpty()) {
       Binding b=remainingBindings.pop();
       IntermediateNode* inode = createIntermediateNode(term, b.var,_useC);
+      inode->addSymbols(syms);
       term=b.term;
 
       *pnode = inode;
@@ -273,6 +422,7 @@ start:
     }
     Leaf* lnode=createLeaf(term);
     *pnode=lnode;
+    lnode->addSymbols(syms);
     lnode->insert(ld);
 
     ensureIntermediateNodeEfficiency(reinterpret_cast<IntermediateNode**>(pparent));
@@ -348,6 +498,7 @@ start:
     ASS((*pnode)->isLeaf());
     ensureLeafEfficiency(reinterpret_cast<Leaf**>(pnode));
     Leaf* leaf = static_cast<Leaf*>(*pnode);
+    leaf->addSymbols(syms);
     leaf->insert(ld);
     return;
   }
@@ -609,6 +760,8 @@ SubstitutionTree::Node::~Node()
 {
   CALL("SubstitutionTree::Node::~Node");
 
+  env.statistics->substTreeNodes--;
+
   if(term.isTerm()) {
     term.term()->destroyNonShared();
   }
@@ -622,6 +775,7 @@ void SubstitutionTree::Node::split(Node** pnode, TermList* where, int var)
   Node* node=*pnode;
 
   IntermediateNode* newNode = createIntermediateNode(node->term, var,node->withSorts());
+  newNode->copySymbols(node);
   node->term=*where;
   *pnode=newNode;
 
@@ -704,6 +858,12 @@ clientBDRecording(false), tree(parent), useConstraints(useC)
   queryNormalizer.normalizeVariables(query);
   Term* queryNorm=queryNormalizer.apply(query);
 
+  if(!withoutTop && !useConstraints && query->ground()) {
+    querySymbols=argumentSymbols(query);
+  } else {
+    querySymbols=~0ull;
+  }
+
   if(withoutTop){
     subst.bindSpecialVar(0,TermList(queryNorm),NORM_QUERY_BANK);
   }else{
@@ -719,6 +879,8 @@ clientBDRecording(false), tree(parent), useConstraints(useC)
   }
 #endif
 
+  env.statistics->substTreeRetrievals++;
+
   BacktrackData bd;
   enter(root, bd);
   bd.drop();
@@ -890,6 +1052,11 @@ bool SubstitutionTree::UnificationsIterator::enter(Node* n, BacktrackData& bd)
   } 
 #endif
 
+  if(!n->mayContainOnly(querySymbols)) {
+    return false;
+  }
+  env.statistics->substTreeNodesVisited++;
+
   bool success=true;
   bool recording=false;
   if(!n->term.isEmpty()) {
@@ -30,6 +30,8 @@
 
 #include "Forwards.hpp"
 
+#include "Debug/RuntimeStatistics.hpp"
+
 #include "Lib/VirtualIterator.hpp"
 #include "Lib/Metaiterators.hpp"
 #include "Lib/Comparison.hpp"
@@ -151,19 +153,27 @@ public:
     }
   };
 
+  /**
+   * Compact summary of a set of function symbols, the symbol with
+   * number f is represented by the bit f modulo 64
+   */
+  typedef unsigned long long SymbolSet;
+  static SymbolSet symbolBit(unsigned functor) { return 1ull << (functor % 64); }
+  static SymbolSet argumentSymbols(Term* t);
+
   enum NodeAlgorithm
   {
     UNSORTED_LIST=1,
-    SKIP_LIST=2,
+    SORTED_ARRAY=2,
     SET=3
   };
 
   class Node {
   public:
     inline
-    Node() { term.makeEmpty(); }
+    Node() : symbolsAny(0), symbolsAll(~0ull) { term.makeEmpty(); }
     inline
-    Node(TermList ts) : term(ts) { }
+    Node(TermList ts) : term(ts), symbolsAny(0), symbolsAll(~0ull) { }
     virtual ~Node();
     /** True if a leaf node */
     virtual bool isLeaf() const = 0;
@@ -194,6 +204,35 @@ public:
     /** term at this node */
     TermList term;
 
+    /**
+     * Union and intersection of the symbol sets of the entries stored below
+     * this node. They are updated on insertion but not on removal, so they
+     * remain an over- and an under-approximation respectively.
+     */
+    SymbolSet symbolsAny;
+    SymbolSet symbolsAll;
+
+    void addSymbols(SymbolSet syms) { symbolsAny|=syms; symbolsAll&=syms; }
+    void copySymbols(Node* n) { symbolsAny=n->symbolsAny; symbolsAll=n->symbolsAll; }
+    /** Return false if no entry below this node can contain all symbols of @b syms */
+    bool mayContainAllOf(SymbolSet syms) const
+    {
+      if(syms & ~symbolsAny) {
+        RSTAT_CTR_INC("substitution tree nodes skipped by symbol summary");
+        return false;
+      }
+      return true;
+    }
+    /** Return false if every entry below this node contains a symbol outside @b syms */
+    bool mayContainOnly(SymbolSet syms) const
+    {
+      if(symbolsAll & ~syms) {
+        RSTAT_CTR_INC("substitution tree nodes skipped by symbol summary");
+        return false;
+      }
+      return true;
+    }
+
     virtual void print(unsigned depth=0){
        printDepth(depth);
        cout <<  "[" + term.toString() + "]" << endl;
@@ -396,9 +435,10 @@ public:
   };
 
   //These classes and methods are defined in SubstitutionTree_Nodes.cpp
-  class UListLeaf;
-  class SListIntermediateNode;
-  class SListLeaf;
+  class ArrLeaf;
+  class UArrLeaf;
+  class SArrIntermediateNode;
+  class SArrLeaf;
   class SetLeaf;
   static Leaf* createLeaf();
   static Leaf* createLeaf(TermList ts);
@@ -484,83 +524,72 @@ public:
    }
   }; 
 
-  class SListIntermediateNode
+  /**
+   * Intermediate node keeping its children in one contiguous array sorted
+   * by NodePtrComparator, so that variable children come first and the
+   * child with a given top symbol is found by binary search. The array is
+   * terminated by a null pointer, just as the one of UArrIntermediateNode.
+   */
+  class SArrIntermediateNode
   : public IntermediateNode
   {
   public:
-    SListIntermediateNode(unsigned childVar) : IntermediateNode(childVar) {}
-    SListIntermediateNode(TermList ts, unsigned childVar) : IntermediateNode(ts, childVar) {}
+    SArrIntermediateNode(unsigned childVar) : IntermediateNode(childVar), _nodes(0), _size(0), _capacity(0) {}
+    SArrIntermediateNode(TermList ts, unsigned childVar) : IntermediateNode(ts, childVar), _nodes(0), _size(0), _capacity(0) {}
 
-    ~SListIntermediateNode()
+    ~SArrIntermediateNode()
     {
       if(!isEmpty()) {
 	destroyChildren();
       }
+      setCapacity(0);
     }
 
     void removeAllChildren()
     {
-      while(!_nodes.isEmpty()) {
-        _nodes.pop();
+      _size=0;
+      if(_nodes) {
+        _nodes[0]=0;
       }
     }
 
     static IntermediateNode* assimilate(IntermediateNode* orig);
 
     inline
-    NodeAlgorithm algorithm() const { return SKIP_LIST; }
+    NodeAlgorithm algorithm() const { return SORTED_ARRAY; }
     inline
-    bool isEmpty() const { return _nodes.isEmpty(); }
-    int size() const { return _nodes.size(); }
+    bool isEmpty() const { return !_size; }
+    int size() const { return _size; }
 #if VDEBUG
     virtual void assertValid() const
     {
-      ASS_ALLOC_TYPE(this,"SubstitutionTree::SListIntermediateNode");
+      ASS_ALLOC_TYPE(this,"SubstitutionTree::SArrIntermediateNode");
     }
 #endif
     inline
     NodeIterator allChildren()
     {
-      return pvi( NodeSkipList::PtrIterator(_nodes) );
+      return pvi( PointerPtrIterator<Node*>(_nodes,_nodes+_size) );
     }
     inline
     NodeIterator variableChildren()
     {
       return pvi( getWhileLimitedIterator(
-  		    NodeSkipList::PtrIterator(_nodes),
+  		    PointerPtrIterator<Node*>(_nodes,_nodes+_size),
   		    IsPtrToVarNodeFn()) );
     }
-    virtual Node** childByTop(TermList t, bool canCreate)
-    {
-      CALL("SubstitutionTree::SListIntermediateNode::childByTop");
-
-      Node** res;
-      bool found=_nodes.getPosition(t,res,canCreate);
-      if(!found) {
-        if(canCreate) {
-          mightExistAsTop(t);
-          *res=0;
-        } else {
-          res=0;
-        }
-      }
-      return res;
-    }
-    inline
-    void remove(TermList t)
-    {
-      _nodes.remove(t);
-    }
+    virtual Node** childByTop(TermList t, bool canCreate);
+    void remove(TermList t);
 
-    CLASS_NAME(SubstitutionTree::SListIntermediateNode);
-    USE_ALLOCATOR(SListIntermediateNode);
+    CLASS_NAME(SubstitutionTree::SArrIntermediateNode);
+    USE_ALLOCATOR(SArrIntermediateNode);
 
     class NodePtrComparator
     {
     public:
       static Comparison compare(TermList t1,TermList t2)
       {
-	CALL("SubstitutionTree::SListIntermediateNode::NodePtrComparator::compare");
+	CALL("SubstitutionTree::SArrIntermediateNode::NodePtrComparator::compare");
 
 	if(t1.isVar()) {
 	  if(t2.isVar()) {
@@ -579,19 +608,27 @@ public:
       static Comparison compare(TermList t1, Node* n2)
       { return compare(t1, n2->term); }
     };
-    typedef SkipList<Node*,NodePtrComparator> NodeSkipList;
-    NodeSkipList _nodes;
+
+    /** Children sorted by NodePtrComparator, followed by a null pointer */
+    Node** _nodes;
+    unsigned _size;
+  private:
+    unsigned findPosition(TermList t, bool& found) const;
+    void setCapacity(unsigned capacity);
+
+    /** Number of child pointers that fit into @b _nodes, including the terminating null */
+    unsigned _capacity;
   };
 
 
-  class SListIntermediateNodeWithSorts
-  : public SListIntermediateNode
+  class SArrIntermediateNodeWithSorts
+  : public SArrIntermediateNode
   {
    public:
-   SListIntermediateNodeWithSorts(unsigned childVar) : SListIntermediateNode(childVar) {
+   SArrIntermediateNodeWithSorts(unsigned childVar) : SArrIntermediateNode(childVar) {
        _childBySortHelper = new ChildBySortHelper(this);
    }
-   SListIntermediateNodeWithSorts(TermList ts, unsigned childVar) : SListIntermediateNode(ts, childVar) {
+   SArrIntermediateNodeWithSorts(TermList ts, unsigned childVar) : SArrIntermediateNode(ts, childVar) {
        _childBySortHelper = new ChildBySortHelper(this);
    }
   };
@@ -637,6 +674,7 @@ public:
   typedef Stack<unsigned> VarStack;
 
   void getBindings(Term* t, BindingMap& binding);
+  static SymbolSet bindingSymbols(BindingMap& svBindings);
 
   Leaf* findLeaf(Node* root, BindingMap& svBindings);
 
@@ -650,6 +688,27 @@ public:
   /** enable searching with constraints for this tree */
   bool _useC;
 
+  void recordEntry(Term* t, unsigned rootIndex, LeafData ld, bool insert);
+  bool groundEntriesSuffice(Term* query, unsigned rootIndex, bool instances);
+  LDIterator getGroundEntries(Term* key);
+
+  /** Number of entries under each root */
+  ZIArray<unsigned> _rootEntries;
+  /** Number of entries under all roots */
+  size_t _entryCnt;
+
+  /** keep ground entries also in @b _groundEntries */
+  bool _groundIndexing;
+  /**
+   * Leaves holding the ground entries, indexed by their shared term or
+   * literal. Each leaf receives the same insertions and removals as
+   * the leaf of the entry in the tree, so it yields the entries in the
+   * same order.
+   */
+  DHMap<Term*,Leaf*> _groundEntries;
+  /** Number of non-ground entries under each root */
+  ZIArray<unsigned> _nonGroundEntries;
+
   class LeafIterator
   : public IteratorCore<Leaf*>
   {
@@ -717,6 +776,9 @@ public:
     Stack<void*> _alternatives;
     Stack<unsigned> _specVarNumbers;
     Stack<NodeAlgorithm> _nodeTypes;
+
+    /** Symbols of the query, nodes whose entries all contain another symbol are skipped */
+    SymbolSet _querySymbols;
   };
 
   class InstMatcher;
@@ -756,6 +818,9 @@ public:
     Stack<void*> _alternatives;
     Stack<unsigned> _specVarNumbers;
     Stack<NodeAlgorithm> _nodeTypes;
+
+    /** Symbols of the query, nodes whose entries cannot contain all of them are skipped */
+    SymbolSet _querySymbols;
   };
 
   class UnificationsIterator
@@ -803,6 +868,12 @@ public:
     SubstitutionTree* tree;
     bool useConstraints;
     Stack<UnificationConstraint> constraints;
+    /**
+     * Symbols of a ground query. An entry unifying with a ground query
+     * only contains symbols of the query, so nodes whose entries all contain
+     * another symbol are skipped. For other queries all bits are set.
+     */
+    SymbolSet querySymbols;
   };
 
 /*
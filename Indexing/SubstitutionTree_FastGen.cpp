@@ -23,11 +23,14 @@
  */
 
 #include "Lib/Allocator.hpp"
+#include "Lib/Environment.hpp"
 #include "Lib/Recycler.hpp"
 
 #include "Kernel/Matcher.hpp"
 #include "Kernel/SubstHelper.hpp"
 
+#include "Shell/Statistics.hpp"
+
 #include "SubstitutionTree.hpp"
 
 namespace Indexing
@@ -260,6 +263,8 @@ bool SubstitutionTree::GenMatcher::matchNext(unsigned specVar, TermList nodeTerm
 {
   CALL("SubstitutionTree::GenMatcher::matchNext");
 
+  env.statistics->substTreeNodesVisited++;
+
   if(separate) {
     _boundVars.push(BACKTRACK_SEPARATOR);
   }
@@ -374,18 +379,24 @@ SubstitutionTree::FastGeneralizationsIterator::FastGeneralizationsIterator(Subst
 #if VDEBUG
   _tree->_iteratorCnt++;
 #endif
+  env.statistics->substTreeRetrievals++;
 
   _subst=new GenMatcher(query,parent->_nextVar);
 
   if(withoutTop){
     _subst->bindSpecialVar(0,TermList(query));
+    _querySymbols=~0ull;
   }else{
+    _querySymbols=argumentSymbols(query);
    if(reversed) {
      createReversedInitialBindings(query);
    } else {
      createInitialBindings(query);
    }
   }
+  if(!_root->mayContainOnly(_querySymbols)) {
+    _root=0;
+  }
 }
 
 
@@ -532,12 +543,12 @@ main_loop_start:
 	  sibilingsRemain=false;
 	}
       } else {
-	ASS_EQ(parentType,SKIP_LIST)
-	NodeList* alts=static_cast<NodeList*>(currAlt);
-	if(alts->head()->term.isVar()) {
-	  curr=alts->head();
-	  if(alts->tail() && alts->second()->term.isVar()) {
-	    _alternatives.push(alts->tail());
+	ASS_EQ(parentType,SORTED_ARRAY);
+	Node** alts=static_cast<Node**>(currAlt);
+	if((*alts)->term.isVar()) {
+	  curr=*(alts++);
+	  if(*alts && (*alts)->term.isVar()) {
+	    _alternatives.push(alts);
 	    sibilingsRemain=true;
 	  } else {
 	    sibilingsRemain=false;
@@ -559,7 +570,8 @@ main_loop_start:
       //there are no other alternatives
       return false;
     }
-    if(!_subst->matchNext(currSpecVar, curr->term, sibilingsRemain)) {	//[1]
+    if(!curr->mayContainOnly(_querySymbols) ||
+	!_subst->matchNext(currSpecVar, curr->term, sibilingsRemain)) {	//[1]
       //match unsuccessful, try next alternative
       curr=0;
       if(!sibilingsRemain && _alternatives.isNonEmpty()) {
@@ -573,7 +585,7 @@ main_loop_start:
       curr=static_cast<UArrIntermediateNode*>(curr)->_nodes[0];
       ASS(curr);
       ASSERT_VALID(*curr);
-      if(!_subst->matchNext(specVar, curr->term, false)) {
+      if(!curr->mayContainOnly(_querySymbols) || !_subst->matchNext(specVar, curr->term, false)) {
 	//matching failed, let's go back to the node, that had multiple children
 	//_subst->backtrack();
 	if(sibilingsRemain || _alternatives.isNonEmpty()) {
@@ -667,22 +679,20 @@ bool SubstitutionTree::FastGeneralizationsIterator::enterNode(Node*& curr)
       return true;
     }
   } else {
-    NodeList* nl;
-    ASS_EQ(currType, SKIP_LIST);
-    nl=static_cast<SListIntermediateNode*>(inode)->_nodes.toList();
+    ASS_EQ(currType, SORTED_ARRAY);
+    Node** nl=static_cast<SArrIntermediateNode*>(inode)->_nodes;
     if(binding.isTerm()) {
       Node** byTop=inode->childByTop(binding, false);
       if(byTop) {
 	curr=*byTop;
       }
     }
-    if(!curr && nl->head()->term.isVar()) {
-      curr=nl->head();
-      nl=nl->tail();
+    if(!curr && (*nl)->term.isVar()) {
+      curr=*(nl++);
     }
-    //in SkipList nodes variables are only at the beginning
+    //in sorted arrays variables are only at the beginning
     //(so if there aren't any, there aren't any at all)
-    if(nl && nl->head()->term.isTerm()) {
+    if(!*nl || (*nl)->term.isTerm()) {
       nl=0;
     }
     if(curr) {
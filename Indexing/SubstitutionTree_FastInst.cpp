@@ -23,12 +23,15 @@
  */
 
 #include "Lib/Allocator.hpp"
+#include "Lib/Environment.hpp"
 #include "Lib/Recycler.hpp"
 
 #include "Kernel/Matcher.hpp"
 #include "Kernel/SubstHelper.hpp"
 #include "Kernel/TermIterators.hpp"
 
+#include "Shell/Statistics.hpp"
+
 #include "SubstitutionTree.hpp"
 
 namespace Indexing
@@ -422,6 +425,8 @@ bool SubstitutionTree::InstMatcher::matchNext(unsigned specVar, TermList nodeTer
 {
   CALL("SubstitutionTree::InstMatcher::matchNext");
 
+  env.statistics->substTreeNodesVisited++;
+
   if(separate) {
     TermList sep;
     sep.makeEmpty();
@@ -563,6 +568,7 @@ SubstitutionTree::FastInstancesIterator::FastInstancesIterator(SubstitutionTree*
 #if VDEBUG
   _tree->_iteratorCnt++;
 #endif
+  env.statistics->substTreeRetrievals++;
 
   Recycler::get(_subst);
   _subst->reset();
@@ -570,13 +576,18 @@ SubstitutionTree::FastInstancesIterator::FastInstancesIterator(SubstitutionTree*
 
   if(withoutTop){
     _subst->bindSpecialVar(0,TermList(query));
+    _querySymbols=0;
   }else{
+    _querySymbols=argumentSymbols(query);
     if(reversed) {
       createReversedInitialBindings(query);
     } else {
       createInitialBindings(query);
     }
   }
+  if(!_root->mayContainAllOf(_querySymbols)) {
+    _root=0;
+  }
 }
 
 SubstitutionTree::FastInstancesIterator::~FastInstancesIterator()
@@ -717,27 +728,15 @@ main_loop_start:
       //the fact that we have alternatives means that here we are
       //matching by a variable (as there is always at most one child
       //for matching by term)
-      if(parentType==UNSORTED_LIST) {
-	Node** alts=static_cast<Node**>(currAlt);
-	curr=*(alts++);
-	if(*alts) {
-	  _alternatives.push(alts);
-	  sibilingsRemain=true;
-	} else {
-	  sibilingsRemain=false;
-	}
+      //alternatives of both node types are null terminated arrays of children
+      ASS(parentType==UNSORTED_LIST || parentType==SORTED_ARRAY);
+      Node** alts=static_cast<Node**>(currAlt);
+      curr=*(alts++);
+      if(*alts) {
+	_alternatives.push(alts);
+	sibilingsRemain=true;
       } else {
-	ASS_EQ(parentType,SKIP_LIST)
-	NodeList* alts=static_cast<NodeList*>(currAlt);
-	ASS(alts);
-
-	curr=alts->head();
-	if(alts->tail()) {
-	  _alternatives.push(alts->tail());
-	  sibilingsRemain=true;
-	} else {
-	  sibilingsRemain=false;
-	}
+	sibilingsRemain=false;
       }
 
       if(sibilingsRemain) {
@@ -753,7 +752,8 @@ main_loop_start:
       //there are no other alternatives
       return false;
     }
-    if(!_subst->matchNext(currSpecVar, curr->term, sibilingsRemain)) {	//[1]
+    if(!curr->mayContainAllOf(_querySymbols) ||
+	!_subst->matchNext(currSpecVar, curr->term, sibilingsRemain)) {	//[1]
       //match unsuccessful, try next alternative
       curr=0;
       if(!sibilingsRemain && _alternatives.isNonEmpty()) {
@@ -767,7 +767,7 @@ main_loop_start:
       curr=static_cast<UArrIntermediateNode*>(curr)->_nodes[0];
       ASS(curr);
       ASSERT_VALID(*curr);
-      if(!_subst->matchNext(specVar, curr->term, false)) {
+      if(!curr->mayContainAllOf(_querySymbols) || !_subst->matchNext(specVar, curr->term, false)) {
 	//matching failed, let's go back to the node, that had multiple children
 	//_subst->backtrack();
 	if(sibilingsRemain || _alternatives.isNonEmpty()) {
@@ -864,10 +864,9 @@ bool SubstitutionTree::FastInstancesIterator::enterNode(Node*& curr)
       return true;
     }
   } else {
-    NodeList* nl;
-    ASS_EQ(currType, SKIP_LIST);
-    nl=static_cast<SListIntermediateNode*>(inode)->_nodes.toList();
-    ASS(nl); //inode is not empty
+    ASS_EQ(currType, SORTED_ARRAY);
+    Node** nl=static_cast<SArrIntermediateNode*>(inode)->_nodes;
+    ASS(*nl); //inode is not empty
     if(query.isTerm()) {
       //only term with the same top functor will be matched by a term
       Node** byTop=inode->childByTop(query, false);
@@ -879,8 +878,10 @@ bool SubstitutionTree::FastInstancesIterator::enterNode(Node*& curr)
     else {
       ASS(query.isVar());
       //everything is matched by a variable
-      curr=nl->head();
-      nl=nl->tail();
+      curr=*(nl++);
+      if(!*nl) {
+	nl=0;
+      }
     }
 
     if(curr) {
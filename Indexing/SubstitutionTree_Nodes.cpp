@@ -22,94 +22,246 @@
  */
 
 #include "Lib/DHMultiset.hpp"
+#include "Lib/Environment.hpp"
 #include "Lib/Exception.hpp"
-#include "Lib/List.hpp"
 #include "Lib/Metaiterators.hpp"
-#include "Lib/SkipList.hpp"
 #include "Lib/VirtualIterator.hpp"
 
+#include "Shell/Statistics.hpp"
+
 #include "Index.hpp"
 #include "SubstitutionTree.hpp"
 
 namespace Indexing
 {
 
-class SubstitutionTree::UListLeaf
+/**
+ * Account a newly created node in the index statistics.
+ */
+static void recordNodeCreation()
+{
+  Statistics* stats=env.statistics;
+  stats->substTreeNodes++;
+  if(stats->substTreeNodes>stats->maxSubstTreeNodes) {
+    stats->maxSubstTreeNodes=stats->substTreeNodes;
+  }
+}
+
+/**
+ * Account a change of the memory taken by the child and leaf arrays
+ * in the index statistics.
+ */
+static void recordArrayMemory(size_t allocated, size_t released)
+{
+  Statistics* stats=env.statistics;
+  stats->substTreeArrayMemory+=allocated;
+  stats->substTreeArrayMemory-=released;
+  if(stats->substTreeArrayMemory>stats->maxSubstTreeArrayMemory) {
+    stats->maxSubstTreeArrayMemory=stats->substTreeArrayMemory;
+  }
+}
+
+/**
+ * Leaf keeping its entries in one contiguous array.
+ *
+ * Most leaves hold a single entry, so the first entry is stored in
+ * the leaf object itself and the array is moved out of it only when
+ * the leaf grows. When entries are removed, the array is shrunk
+ * again, so that leaves emptied by backward simplification do not
+ * keep their memory.
+ */
+class SubstitutionTree::ArrLeaf
 : public Leaf
 {
 public:
   inline
-  UListLeaf() : _children(0), _size(0) {}
+  ArrLeaf() : _children(&_inline), _size(0), _capacity(1) {}
   inline
-  UListLeaf(TermList ts) : Leaf(ts), _children(0), _size(0) {}
-  ~UListLeaf()
+  ArrLeaf(TermList ts) : Leaf(ts), _children(&_inline), _size(0), _capacity(1) {}
+  ~ArrLeaf()
   {
-    LDList::destroy(_children);
+    _size=0;
+    setCapacity(1);
   }
 
   inline
-  NodeAlgorithm algorithm() const { return UNSORTED_LIST; }
-  inline
-  bool isEmpty() const { return !_children; }
+  bool isEmpty() const { return !_size; }
   inline
   int size() const { return _size; }
   inline
   LDIterator allChildren()
   {
-    return pvi( LDList::RefIterator(_children) );
+    return pvi( PointerRefIterator<LeafData>(_children,_children+_size) );
+  }
+
+protected:
+  void insertAt(unsigned pos, LeafData ld);
+  void removeAt(unsigned pos);
+
+  LeafData* _children;
+  unsigned _size;
+private:
+  void setCapacity(unsigned capacity);
+
+  /** Number of entries that fit into @b _children, one if it is @b _inline */
+  unsigned _capacity;
+  LeafData _inline;
+};
+
+/**
+ * Change the capacity of the array of entries to @b capacity, which
+ * must be at least the number of entries. The capacity of one stands
+ * for the entry stored inside the leaf.
+ */
+void SubstitutionTree::ArrLeaf::setCapacity(unsigned capacity)
+{
+  CALL("SubstitutionTree::ArrLeaf::setCapacity");
+  ASS_GE(capacity,_size);
+  ASS_G(capacity,0);
+
+  if(capacity==_capacity) {
+    return;
+  }
+  LeafData* mem;
+  if(capacity==1) {
+    mem=&_inline;
+  } else {
+    mem=static_cast<LeafData*>(ALLOC_KNOWN(capacity*sizeof(LeafData),"SubstitutionTree::ArrLeaf"));
+  }
+  for(unsigned i=0;i<_size;i++) {
+    mem[i]=_children[i];
+  }
+  size_t released=0;
+  if(_capacity!=1) {
+    DEALLOC_KNOWN(_children,_capacity*sizeof(LeafData),"SubstitutionTree::ArrLeaf");
+    released=_capacity*sizeof(LeafData);
+  }
+  recordArrayMemory(capacity==1 ? 0 : capacity*sizeof(LeafData), released);
+  _children=mem;
+  _capacity=capacity;
+}
+
+void SubstitutionTree::ArrLeaf::insertAt(unsigned pos, LeafData ld)
+{
+  CALL("SubstitutionTree::ArrLeaf::insertAt");
+  ASS_LE(pos,_size);
+
+  if(_size==_capacity) {
+    setCapacity(_capacity*2);
+  }
+  for(unsigned i=_size;i>pos;i--) {
+    _children[i]=_children[i-1];
+  }
+  _children[pos]=ld;
+  _size++;
+}
+
+void SubstitutionTree::ArrLeaf::removeAt(unsigned pos)
+{
+  CALL("SubstitutionTree::ArrLeaf::removeAt");
+  ASS_L(pos,_size);
+
+  _size--;
+  for(unsigned i=pos;i<_size;i++) {
+    _children[i]=_children[i+1];
   }
+  if(_capacity>1 && _size*4<=_capacity) {
+    setCapacity(_size<=1 ? 1 : _size*2);
+  }
+}
+
+/**
+ * Leaf for a few entries, which are kept in the order of insertion,
+ * the most recently inserted first.
+ */
+class SubstitutionTree::UArrLeaf
+: public ArrLeaf
+{
+public:
+  inline
+  UArrLeaf() {}
+  inline
+  UArrLeaf(TermList ts) : ArrLeaf(ts) {}
+
+  inline
+  NodeAlgorithm algorithm() const { return UNSORTED_LIST; }
   inline
   void insert(LeafData ld)
   {
-    LDList::push(ld, _children);
-    _size++;
+    insertAt(0, ld);
   }
-  inline
   void remove(LeafData ld)
   {
-    _children = LDList::remove(ld, _children);
-    _size--;
+    for(unsigned i=0;i<_size;i++) {
+      if(_children[i]==ld) {
+        removeAt(i);
+        return;
+      }
+    }
+    ASSERTION_VIOLATION;
   }
 
-  CLASS_NAME(SubstitutionTree::UListLeaf);
-  USE_ALLOCATOR(UListLeaf);
-private:
-  typedef List<LeafData> LDList;
-  LDList* _children;
-  int _size;
+  CLASS_NAME(SubstitutionTree::UArrLeaf);
+  USE_ALLOCATOR(UArrLeaf);
 };
 
 
-class SubstitutionTree::SListLeaf
-: public Leaf
+/**
+ * Leaf whose entries are kept sorted by LDComparator, so that they
+ * can be found by binary search.
+ */
+class SubstitutionTree::SArrLeaf
+: public ArrLeaf
 {
 public:
-  SListLeaf() {}
-  SListLeaf(TermList ts) : Leaf(ts) {}
+  SArrLeaf() {}
+  SArrLeaf(TermList ts) : ArrLeaf(ts) {}
 
-  static SListLeaf* assimilate(Leaf* orig);
+  static SArrLeaf* assimilate(Leaf* orig);
 
   inline
-  NodeAlgorithm algorithm() const { return SKIP_LIST; }
-  inline
-  bool isEmpty() const { return _children.isEmpty(); }
-#if VDEBUG
-  inline
-  int size() const { return _children.size(); }
-#endif
-  inline
-  LDIterator allChildren()
+  NodeAlgorithm algorithm() const { return SORTED_ARRAY; }
+  void insert(LeafData ld)
   {
-    return pvi( LDSkipList::RefIterator(_children) );
+    bool found;
+    insertAt(findPosition(ld,found), ld);
+  }
+  void remove(LeafData ld)
+  {
+    bool found;
+    unsigned pos=findPosition(ld,found);
+    ASS(found);
+    removeAt(pos);
   }
-  void insert(LeafData ld) { _children.insert(ld); }
-  void remove(LeafData ld) { _children.remove(ld); }
 
-  CLASS_NAME(SubstitutionTree::SListLeaf);
-  USE_ALLOCATOR(SListLeaf);
+  CLASS_NAME(SubstitutionTree::SArrLeaf);
+  USE_ALLOCATOR(SArrLeaf);
 private:
-  typedef SkipList<LeafData,LDComparator> LDSkipList;
-  LDSkipList _children;
+  /**
+   * Return the position of @b ld among the entries, or the position
+   * where it should be inserted if it is not there
+   */
+  unsigned findPosition(const LeafData& ld, bool& found) const
+  {
+    unsigned lo=0;
+    unsigned hi=_size;
+    while(lo<hi) {
+      unsigned mid=(lo+hi)/2;
+      switch(LDComparator::compare(ld,_children[mid])) {
+      case LESS:
+        hi=mid;
+        break;
+      case GREATER:
+        lo=mid+1;
+        break;
+      case EQUAL:
+        found=true;
+        return mid;
+      }
+    }
+    found=false;
+    return lo;
+  }
 
   friend class SubstitutionTree;
 };
@@ -117,17 +269,20 @@ private:
 
 SubstitutionTree::Leaf* SubstitutionTree::createLeaf()
 {
-  return new UListLeaf();
+  recordNodeCreation();
+  return new UArrLeaf();
 }
 
 SubstitutionTree::Leaf* SubstitutionTree::createLeaf(TermList ts)
 {
-  return new UListLeaf(ts);
+  recordNodeCreation();
+  return new UArrLeaf(ts);
 }
 
 SubstitutionTree::IntermediateNode* SubstitutionTree::createIntermediateNode(unsigned childVar,bool useC)
 {
   CALL("SubstitutionTree::createIntermediateNode/2");
+  recordNodeCreation();
   if(useC){ return new UArrIntermediateNodeWithSorts(childVar); }
   return new UArrIntermediateNode(childVar);
 }
@@ -135,6 +290,7 @@ SubstitutionTree::IntermediateNode* SubstitutionTree::createIntermediateNode(uns
 SubstitutionTree::IntermediateNode* SubstitutionTree::createIntermediateNode(TermList ts, unsigned childVar,bool useC)
 {
   CALL("SubstitutionTree::createIntermediateNode/3");
+  recordNodeCreation();
   if(useC){ return new UArrIntermediateNodeWithSorts(ts, childVar); }
   return new UArrIntermediateNode(ts, childVar);
 }
@@ -195,21 +351,117 @@ void SubstitutionTree::UArrIntermediateNode::remove(TermList t)
   ASSERTION_VIOLATION;
 }
 
+/**
+ * Return the position of the child with the top symbol of @b t,
+ * or the position where it should be inserted if there is none
+ */
+unsigned SubstitutionTree::SArrIntermediateNode::findPosition(TermList t, bool& found) const
+{
+  unsigned lo=0;
+  unsigned hi=_size;
+  while(lo<hi) {
+    unsigned mid=(lo+hi)/2;
+    switch(NodePtrComparator::compare(t,_nodes[mid])) {
+    case LESS:
+      hi=mid;
+      break;
+    case GREATER:
+      lo=mid+1;
+      break;
+    case EQUAL:
+      found=true;
+      return mid;
+    }
+  }
+  found=false;
+  return lo;
+}
+
+/**
+ * Change the capacity of the child array to @b capacity, which must
+ * leave room for the children and the terminating null pointer,
+ * or be zero if there are no children.
+ */
+void SubstitutionTree::SArrIntermediateNode::setCapacity(unsigned capacity)
+{
+  CALL("SubstitutionTree::SArrIntermediateNode::setCapacity");
+  ASS(capacity>_size || (!capacity && !_size));
+
+  Node** mem=0;
+  if(capacity) {
+    mem=static_cast<Node**>(ALLOC_KNOWN(capacity*sizeof(Node*),"SubstitutionTree::SArrIntermediateNode"));
+    for(unsigned i=0;i<_size;i++) {
+      mem[i]=_nodes[i];
+    }
+    mem[_size]=0;
+  }
+  if(_nodes) {
+    DEALLOC_KNOWN(_nodes,_capacity*sizeof(Node*),"SubstitutionTree::SArrIntermediateNode");
+  }
+  recordArrayMemory(capacity*sizeof(Node*), _capacity*sizeof(Node*));
+  _nodes=mem;
+  _capacity=capacity;
+}
+
+SubstitutionTree::Node** SubstitutionTree::SArrIntermediateNode::
+	childByTop(TermList t, bool canCreate)
+{
+  CALL("SubstitutionTree::SArrIntermediateNode::childByTop");
+
+  bool found;
+  unsigned pos=findPosition(t,found);
+  if(found) {
+    return &_nodes[pos];
+  }
+  if(!canCreate) {
+    return 0;
+  }
+  mightExistAsTop(t);
+  if(_size+2>_capacity) {
+    setCapacity(_capacity ? _capacity*2 : 8);
+  }
+  //shift the children together with the terminating null
+  for(unsigned i=_size+1;i>pos;i--) {
+    _nodes[i]=_nodes[i-1];
+  }
+  _nodes[pos]=0;
+  _size++;
+  return &_nodes[pos];
+}
+
+void SubstitutionTree::SArrIntermediateNode::remove(TermList t)
+{
+  CALL("SubstitutionTree::SArrIntermediateNode::remove");
+
+  bool found;
+  unsigned pos=findPosition(t,found);
+  ASS(found);
+  for(unsigned i=pos;i<_size;i++) {
+    _nodes[i]=_nodes[i+1];
+  }
+  _size--;
+  if(_capacity>8 && (_size+1)*4<=_capacity) {
+    setCapacity(_capacity/2);
+  }
+}
+
 /**
  * Take an IntermediateNode, destroy it, and return
- * SListIntermediateNode with the same content.
+ * SArrIntermediateNode with the same content.
  */
-SubstitutionTree::IntermediateNode* SubstitutionTree::SListIntermediateNode
+SubstitutionTree::IntermediateNode* SubstitutionTree::SArrIntermediateNode
 	::assimilate(IntermediateNode* orig)
 {
-  CALL("SubstitutionTree::SListIntermediateNode::assimilate");
+  CALL("SubstitutionTree::SArrIntermediateNode::assimilate");
 
+  recordNodeCreation();
   IntermediateNode* res= 0;
   if(orig->withSorts()){
-    res = new SListIntermediateNodeWithSorts(orig->term, orig->childVar);
+    res = new SArrIntermediateNodeWithSorts(orig->term, orig->childVar);
   }else{
-    res = new SListIntermediateNode(orig->term, orig->childVar);
+    res = new SArrIntermediateNode(orig->term, orig->childVar);
   }
+  res->copySymbols(orig);
   res->loadChildren(orig->allChildren());
   orig->makeEmpty();
   delete orig;
@@ -217,14 +469,16 @@ SubstitutionTree::IntermediateNode* SubstitutionTree::SListIntermediateNode
 }
 
 /**
- * Take a Leaf, destroy it, and return SListLeaf
+ * Take a Leaf, destroy it, and return SArrLeaf
  * with the same content.
  */
-SubstitutionTree::SListLeaf* SubstitutionTree::SListLeaf::assimilate(Leaf* orig)
+SubstitutionTree::SArrLeaf* SubstitutionTree::SArrLeaf::assimilate(Leaf* orig)
 {
-  CALL("SubstitutionTree::SListLeaf::assimilate");
+  CALL("SubstitutionTree::SArrLeaf::assimilate");
 
-  SListLeaf* res=new SListLeaf(orig->term);
+  recordNodeCreation();
+  SArrLeaf* res=new SArrLeaf(orig->term);
+  res->copySymbols(orig);
   res->loadChildren(orig->allChildren());
   orig->makeEmpty();
   delete orig;
@@ -236,7 +490,7 @@ void SubstitutionTree::ensureLeafEfficiency(Leaf** leaf)
   CALL("SubstitutionTree::ensureLeafEfficiency");
 
   if( (*leaf)->algorithm()==UNSORTED_LIST && (*leaf)->size()>5 ) {
-    *leaf=SListLeaf::assimilate(*leaf);
+    *leaf=SArrLeaf::assimilate(*leaf);
   }
 }
 
@@ -245,7 +499,7 @@ void SubstitutionTree::ensureIntermediateNodeEfficiency(IntermediateNode** inode
   CALL("SubstitutionTree::ensureIntermediateNodeEfficiency");
 
   if( (*inode)->algorithm()==UNSORTED_LIST && (*inode)->size()>3 ) {
-    *inode=SListIntermediateNode::assimilate(*inode);
+    *inode=SArrIntermediateNode::assimilate(*inode);
   }
 }
 
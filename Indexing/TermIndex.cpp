@@ -66,6 +66,11 @@ TermQueryResultIterator TermIndex::getInstances(TermList t,
   return _is->getInstances(t, retrieveSubstitutions);
 }
 
+size_t TermIndex::getUnificationCountEstimate(TermList t)
+{
+  return _is->getUnificationCountEstimate(t);
+}
+
 
 void SuperpositionSubtermIndex::handleClause(Clause* c, bool adding)
 {
@@ -158,6 +163,7 @@ void DemodulationLHSIndex::handleClause(Clause* c, bool adding)
   while (lhsi.hasNext()) {
     if (adding) {
       _is->insert(lhsi.next(), lit, c);
+      _generation++;
     }
     else {
       _is->remove(lhsi.next(), lit, c);
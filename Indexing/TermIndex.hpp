@@ -47,6 +47,8 @@ public:
   TermQueryResultIterator getInstances(TermList t,
 	  bool retrieveSubstitutions = true);
 
+  size_t getUnificationCountEstimate(TermList t);
+
 protected:
   TermIndex(TermIndexingStructure* is) : _is(is) {}
 
@@ -111,12 +113,21 @@ public:
   USE_ALLOCATOR(DemodulationLHSIndex);
 
   DemodulationLHSIndex(TermIndexingStructure* is, Ordering& ord, const Options& opt)
-  : TermIndex(is), _ord(ord), _opt(opt) {};
+  : TermIndex(is), _ord(ord), _opt(opt), _generation(0) {};
+
+  /**
+   * Return a counter that is increased whenever a new rewrite rule is
+   * inserted into the index. A term that cannot be rewritten by the
+   * index at some generation stays irreducible while the generation
+   * does not change (removal of rules cannot enable a rewrite).
+   */
+  unsigned generation() const { return _generation; }
 protected:
   void handleClause(Clause* c, bool adding);
 private:
   Ordering& _ord;
   const Options& _opt;
+  unsigned _generation;
 };
 
 };
@@ -47,6 +47,13 @@ public:
 
   virtual bool generalizationExists(TermList t) { NOT_IMPLEMENTED; }
 
+  /**
+   * Return an estimate of the number of unifications of @b t
+   * that is obtained without retrieving them
+   */
+  virtual size_t getUnificationCountEstimate(TermList t)
+  { return countIteratorElements(getUnifications(t, false)); }
+
 #if VDEBUG
   virtual void markTagged() = 0;
 #endif
@@ -46,7 +46,8 @@ TermSharing::TermSharing()
     _totalLiterals(0),
     // _groundLiterals(0), //MS: unused
     _literalInsertions(0),
-    _termInsertions(0)
+    _termInsertions(0),
+    _hasSymbolWeights(false)
 {
   CALL("TermSharing::TermSharing");
 }
@@ -128,6 +129,9 @@ Term* TermSharing::insert(Term* t)
     t->markShared();
     t->setVars(vars);
     t->setWeight(weight);
+    if (_hasSymbolWeights) {
+      symbolWeight(t);
+    }
     if (env.colorUsed) {
       Color fcolor = env.signature->getFunction(t->functor())->color();
       color = static_cast<Color>(color | fcolor);
@@ -148,6 +152,48 @@ Term* TermSharing::insert(Term* t)
   return s;
 } // TermSharing::insert
 
+/**
+ * Set the weights of symbols used by symbolWeight(). From now on,
+ * the symbol weight of each new term and literal is computed when it is
+ * inserted. Terms that are already shared compute it on first use.
+ *
+ * The table can be set only once, before any symbol weight is used.
+ */
+void TermSharing::setSymbolWeights(const DArray<unsigned>& functionWeights, const DArray<unsigned>& predicateWeights)
+{
+  CALL("TermSharing::setSymbolWeights");
+  ASS(!_hasSymbolWeights);
+
+  _functionSymbolWeights.initFromArray(functionWeights.size(), functionWeights);
+  _predicateSymbolWeights.initFromArray(predicateWeights.size(), predicateWeights);
+  _hasSymbolWeights = true;
+} // TermSharing::setSymbolWeights
+
+/**
+ * Return the weight of the shared term or literal @b t with the symbols
+ * weighted by the symbol weight table. Each variable has weight 1.
+ * Without a table this is the same as weight().
+ *
+ * The weights are cached in a map rather than in the terms, so that
+ * terms do not grow when no table is used.
+ */
+unsigned TermSharing::symbolWeight(const Term* t)
+{
+  CALL("TermSharing::symbolWeight");
+  ASS(t->shared());
+
+  unsigned res;
+  if (_symbolWeightCache.find(t, res)) {
+    return res;
+  }
+  res = t->isLiteral() ? predicateSymbolWeight(t->functor()) : functionSymbolWeight(t->functor());
+  for (const TermList* ts = t->args(); ! ts->isEmpty(); ts = ts->next()) {
+    res += ts->isVar() ? 1 : symbolWeight(ts->term());
+  }
+  _symbolWeightCache.insert(t, res);
+  return res;
+} // TermSharing::symbolWeight
+
 /**
  * Insert a new literal in the index and return the result.
  *
@@ -207,6 +253,9 @@ Literal* TermSharing::insert(Literal* t)
     t->markShared();
     t->setVars(vars);
     t->setWeight(weight);
+    if (_hasSymbolWeights) {
+      symbolWeight(t);
+    }
     if (env.colorUsed) {
       Color fcolor = env.signature->getPredicate(t->functor())->color();
       color = static_cast<Color>(color | fcolor);
@@ -256,6 +305,9 @@ Literal* TermSharing::insertVariableEquality(Literal* t,unsigned sort)
   if (s == t) {
     t->markShared();
     t->setWeight(3);
+    if (_hasSymbolWeights) {
+      symbolWeight(t);
+    }
     if (env.colorUsed) {
       t->setColor(COLOR_TRANSPARENT);
     }
@@ -26,6 +26,8 @@
 #ifndef __TermSharing__
 #define __TermSharing__
 
+#include "Lib/DArray.hpp"
+#include "Lib/DHMap.hpp"
 #include "Lib/Set.hpp"
 #include "Kernel/Term.hpp"
 
@@ -53,6 +55,18 @@ public:
 
   Literal* tryGetOpposite(Literal* l);
 
+  void setSymbolWeights(const DArray<unsigned>& functionWeights, const DArray<unsigned>& predicateWeights);
+  unsigned symbolWeight(const Term* t);
+  /** True if a symbol weight table was set by setSymbolWeights() */
+  bool hasSymbolWeights() const { return _hasSymbolWeights; }
+
+  /** Weight of the function symbol @b f in Term::symbolWeight(), 1 for symbols not in the table */
+  unsigned functionSymbolWeight(unsigned f) const
+  { return f<_functionSymbolWeights.size() ? _functionSymbolWeights[f] : 1; }
+  /** Weight of the predicate symbol @b p in Term::symbolWeight(), 1 for symbols not in the table */
+  unsigned predicateSymbolWeight(unsigned p) const
+  { return p<_predicateSymbolWeights.size() ? _predicateSymbolWeights[p] : 1; }
+
   /** The hash function of this literal */
   inline static unsigned hash(const Literal* l)
   { return l->hash(); }
@@ -92,6 +106,14 @@ private:
   unsigned _literalInsertions;
   /** Number of term insertions */
   unsigned _termInsertions;
+
+  bool _hasSymbolWeights;
+  /** Weights of function symbols, indexed by functor */
+  DArray<unsigned> _functionSymbolWeights;
+  /** Weights of predicate symbols, indexed by functor */
+  DArray<unsigned> _predicateSymbolWeights;
+  /** Symbol weights of the shared terms and literals computed so far */
+  DHMap<const Term*,unsigned> _symbolWeightCache;
 }; // class TermSharing
 
 } // namespace Indexing
@@ -42,7 +42,7 @@ using namespace Lib;
 using namespace Kernel;
 
 TermSubstitutionTree::TermSubstitutionTree(bool useC)
-: SubstitutionTree(env.signature->functions(),useC)
+: SubstitutionTree(env.signature->functions(),useC), _varCnt(0)
 {
 }
 
@@ -69,9 +69,11 @@ void TermSubstitutionTree::handleTerm(TermList t, Literal* lit, Clause* cls, boo
   if(t.isOrdinaryVar()) {
     if(insert) {
       _vars.insert(ld);
+      _varCnt++;
     } else {
       // why is this case needed?
       _vars.remove(ld);
+      _varCnt--;
     }
   } else {
     ASS(t.isTerm());
@@ -83,6 +85,7 @@ void TermSubstitutionTree::handleTerm(TermList t, Literal* lit, Clause* cls, boo
     getBindings(normTerm, svBindings);
 
     unsigned rootNodeIndex=getRootNodeIndex(normTerm);
+    recordEntry(term, rootNodeIndex, ld, insert);
 
     if(insert) {
       SubstitutionTree::insert(&_nodes[rootNodeIndex], svBindings, ld);
@@ -101,15 +104,20 @@ TermQueryResultIterator TermSubstitutionTree::getUnifications(TermList t,
     return getAllUnifyingIterator(t,retrieveSubstitutions,false);
   } else {
     ASS(t.isTerm());
-    if(_vars.isEmpty()) {
+    TermQueryResultIterator treeResults;
+    if(groundEntriesSuffice(t.term(), getRootNodeIndex(t.term()), false)) {
+      treeResults = ldIteratorToTQRIterator(getGroundEntries(t.term()), t, retrieveSubstitutions,false);
+    } else {
       // false here means without constraints
-      return getResultIterator<UnificationsIterator>(t.term(), retrieveSubstitutions,false);
+      treeResults = getResultIterator<UnificationsIterator>(t.term(), retrieveSubstitutions,false);
+    }
+    if(_vars.isEmpty()) {
+      return treeResults;
     } else {
       return pvi( getConcatenatedIterator(
           // false here means without constraints
 	  ldIteratorToTQRIterator(LDSkipList::RefIterator(_vars), t, retrieveSubstitutions,false),
-          // false here means without constraints
-	  getResultIterator<UnificationsIterator>(t.term(), retrieveSubstitutions,false)) );
+	  treeResults) );
     }
   }
 }
@@ -176,12 +184,18 @@ TermQueryResultIterator TermSubstitutionTree::getGeneralizations(TermList t,
     return ldIteratorToTQRIterator(LDSkipList::RefIterator(_vars), t, retrieveSubstitutions,false);
   } else {
     ASS(t.isTerm());
+    TermQueryResultIterator treeResults;
+    if(groundEntriesSuffice(t.term(), getRootNodeIndex(t.term()), false)) {
+      treeResults = ldIteratorToTQRIterator(getGroundEntries(t.term()), t, retrieveSubstitutions,false);
+    } else {
+      treeResults = getResultIterator<FastGeneralizationsIterator>(t.term(), retrieveSubstitutions,false);
+    }
     if(_vars.isEmpty()) {
-      return getResultIterator<FastGeneralizationsIterator>(t.term(), retrieveSubstitutions,false);
+      return treeResults;
     } else {
       return pvi( getConcatenatedIterator(
 	      ldIteratorToTQRIterator(LDSkipList::RefIterator(_vars), t, retrieveSubstitutions,false),
-	      getResultIterator<FastGeneralizationsIterator>(t.term(), retrieveSubstitutions,false)) );
+	      treeResults) );
     }
   }
 }
@@ -194,10 +208,28 @@ TermQueryResultIterator TermSubstitutionTree::getInstances(TermList t,
     return getAllUnifyingIterator(t,retrieveSubstitutions,false);
   } else {
     ASS(t.isTerm());
+    if(groundEntriesSuffice(t.term(), getRootNodeIndex(t.term()), true)) {
+      return ldIteratorToTQRIterator(getGroundEntries(t.term()), t, retrieveSubstitutions,false);
+    }
     return getResultIterator<FastInstancesIterator>(t.term(), retrieveSubstitutions,false);
   }
 }
 
+/**
+ * Return the number of entries that may unify with @b t, i.e. all
+ * variable entries and the entries with the same top functor as @b t
+ */
+size_t TermSubstitutionTree::getUnificationCountEstimate(TermList t)
+{
+  CALL("TermSubstitutionTree::getUnificationCountEstimate");
+
+  if(t.isOrdinaryVar()) {
+    return _varCnt+_entryCnt;
+  }
+  ASS(t.isTerm());
+  return _varCnt+_rootEntries[getRootNodeIndex(t.term())];
+}
+
 /**
  * Functor, that transforms &b QueryResult struct into
  * @b TermQueryResult.
@@ -62,6 +62,8 @@ public:
   TermQueryResultIterator getInstances(TermList t,
 	  bool retrieveSubstitutions);
 
+  size_t getUnificationCountEstimate(TermList t);
+
 #if VDEBUG
   virtual void markTagged(){ SubstitutionTree::markTagged();}
 #endif
@@ -97,6 +99,8 @@ private:
 
   typedef SkipList<LeafData,LDComparator> LDSkipList;
   LDSkipList _vars;
+  /** Number of entries in @b _vars */
+  unsigned _varCnt;
 };
 
 };
@@ -22,6 +22,7 @@
  */
 
 
+#include "Lib/DHMap.hpp"
 #include "Lib/DHMultiset.hpp"
 #include "Lib/Environment.hpp"
 #include "Lib/Int.hpp"
@@ -99,6 +100,9 @@ struct BackwardDemodulation::ResultFn
 {
   typedef DHMultiset<Clause*> ClauseSet;
 
+  CLASS_NAME(BackwardDemodulation::ResultFn);
+  USE_ALLOCATOR(BackwardDemodulation::ResultFn);
+
   ResultFn(Clause* cl, BackwardDemodulation& parent)
   : _cl(cl), _parent(parent), _ordering(parent._salg->getOrdering())
   {
@@ -107,6 +111,17 @@ struct BackwardDemodulation::ResultFn
     _eqSort = SortHelper::getEqualityArgumentSort(_eqLit);
     _removed=SmartPtr<ClauseSet>(new ClauseSet());
   }
+  /**
+   * Create the functor with a set of removed clauses shared among
+   * several premises (used for batched backward demodulation)
+   */
+  ResultFn(Clause* cl, BackwardDemodulation& parent, SmartPtr<ClauseSet> removed)
+  : _cl(cl), _removed(removed), _parent(parent), _ordering(parent._salg->getOrdering())
+  {
+    ASS_EQ(_cl->length(),1);
+    _eqLit=(*_cl)[0];
+    _eqSort = SortHelper::getEqualityArgumentSort(_eqLit);
+  }
   DECL_RETURN_TYPE(BwSimplificationRecord);
   /**
    * Return pair of clauses. First clause is being replaced,
@@ -129,6 +144,10 @@ struct BackwardDemodulation::ResultFn
       //backward demodulation
       return BwSimplificationRecord(0);
     }
+    if(_removed->find(_cl)) {
+      //the premise itself was simplified by another member of the batch
+      return BwSimplificationRecord(0);
+    }
 
     unsigned qrSort = SortHelper::getTermSort(qr.term, qr.literal);
     if(qrSort!=_eqSort) {
@@ -200,7 +219,7 @@ struct BackwardDemodulation::ResultFn
     if(EqHelper::isEqTautology(resLit)) {
       env.statistics->backwardDemodulationsToEqTaut++;
       _removed->insert(qr.clause);
-      return BwSimplificationRecord(qr.clause);
+      return BwSimplificationRecord(qr.clause,0,_cl);
     }
 
 
@@ -226,7 +245,7 @@ struct BackwardDemodulation::ResultFn
     env.statistics->backwardDemodulations++;
 
     _removed->insert(qr.clause);
-    return BwSimplificationRecord(qr.clause,res);
+    return BwSimplificationRecord(qr.clause,res,_cl);
   }
 private:
   unsigned _eqSort;
@@ -267,4 +286,78 @@ void BackwardDemodulation::perform(Clause* cl,
   simplifications=getPersistentIterator(replacementIterator);
 }
 
+/**
+ * Perform backward demodulation with a batch of unit equalities
+ *
+ * The index is queried only once for each distinct left-hand side
+ * occurring in the batch, and each retrieved instance is offered to
+ * the demodulators sharing that left-hand side until one of them
+ * succeeds. A clause is rewritten by at most one demodulator of the
+ * batch; the remaining ones will be applied to its replacement by
+ * forward demodulation.
+ */
+void BackwardDemodulation::performBatch(ClauseStack& premises,
+	BwSimplificationRecordIterator& simplifications)
+{
+  CALL("BackwardDemodulation::performBatch");
+
+  TimeCounter tc(TC_BACKWARD_DEMODULATION);
+
+  typedef List<ResultFn*> FnList;
+
+  SmartPtr<ResultFn::ClauseSet> removed(new ResultFn::ClauseSet());
+  Stack<ResultFn*> fns;
+  //distinct left-hand sides in the order of their first occurrence
+  Stack<TermList> lhss;
+  DHMap<TermList,FnList*> lhsUsers;
+
+  ClauseStack::Iterator pit(premises);
+  while(pit.hasNext()) {
+    Clause* cl=pit.next();
+    if(cl->length()!=1 || !(*cl)[0]->isEquality() || !(*cl)[0]->isPositive() ) {
+      continue;
+    }
+    ResultFn* fn=new ResultFn(cl, *this, removed);
+    fns.push(fn);
+
+    TermIterator lhsIt=EqHelper::getDemodulationLHSIterator((*cl)[0], false, _salg->getOrdering(), _salg->getOptions());
+    while(lhsIt.hasNext()) {
+      TermList lhs=lhsIt.next();
+      FnList** users;
+      if(lhsUsers.getValuePtr(lhs, users, 0)) {
+	lhss.push(lhs);
+      }
+      *users=FnList::addLast(*users, fn);
+    }
+  }
+
+  static Stack<BwSimplificationRecord> records;
+  records.reset();
+
+  Stack<TermList>::Iterator lit(lhss);
+  while(lit.hasNext()) {
+    TermList lhs=lit.next();
+    FnList* users=lhsUsers.get(lhs);
+    TermQueryResultIterator qrit=_index->getInstances(lhs, true);
+    while(qrit.hasNext()) {
+      pair<TermList,TermQueryResult> arg(lhs, qrit.next());
+      FnList::Iterator uit(users);
+      while(uit.hasNext()) {
+	BwSimplificationRecord srec=(*uit.next())(arg);
+	if(srec.toRemove) {
+	  records.push(srec);
+	  break;
+	}
+      }
+    }
+    FnList::destroy(users);
+  }
+
+  while(fns.isNonEmpty()) {
+    delete fns.pop();
+  }
+
+  simplifications=getPersistentIterator(Stack<BwSimplificationRecord>::Iterator(records));
+}
+
 }
@@ -46,6 +46,7 @@ public:
   void detach();
 
   void perform(Clause* premise, BwSimplificationRecordIterator& simplifications);
+  void performBatch(ClauseStack& premises, BwSimplificationRecordIterator& simplifications);
 private:
   struct RemovedIsNonzeroFn;
   struct RewritableClausesFn;
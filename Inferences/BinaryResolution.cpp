@@ -185,17 +185,25 @@ Clause* BinaryResolution::generateClause(Clause* queryCl, Literal* queryLit, SLQ
       env.statistics->discardedNonRedundantClauses++;
       return 0;
     }
+
+    // when the substitution knows the weights of the instances, a conclusion over the weight
+    // limit is discarded before any of its literals gets inserted into the term sharing
+    size_t conclusionWeight = 0;
+    if(qr.substitution->addApplicationWeight(queryCl, queryLit, false, conclusionWeight) &&
+       qr.substitution->addApplicationWeight(qr.clause, qr.literal, true, conclusionWeight) &&
+       conclusionWeight > weightLimit) {
+      RSTAT_CTR_INC("binary resolutions skipped for weight limit before building literals");
+      env.statistics->discardedNonRedundantClauses++;
+      return 0;
+    }
   }
 
   unsigned conlength = withConstraints ? constraints->size() : 0;
-  unsigned newLength = clength+dlength-2+conlength;
 
-  Inference* inf = new Inference2((withConstraints?Inference::CONSTRAINED_RESOLUTION:Inference::RESOLUTION), 
-                                  queryCl, qr.clause);
-  Unit::InputType inpType = (Unit::InputType)
-  	Int::max(queryCl->inputType(), qr.clause->inputType());
-
-  Clause* res = new(newLength) Clause(newLength, inpType, inf);
+  // The literals of the conclusion are collected in a reusable buffer, the clause
+  // and its inference are only created when the conclusion passes all the checks
+  static LiteralStack resLits;
+  resLits.reset();
 
   Literal* queryLitAfter = 0;
   if (ord && queryCl->numSelected() > 1) {
@@ -216,7 +224,6 @@ Clause* BinaryResolution::generateClause(Clause* queryCl, Literal* queryLit, SLQ
   //}
 #endif
 
-  unsigned next = 0;
   if(withConstraints){
   for(unsigned i=0;i<constraints->size();i++){
       pair<TermList,TermList> con = (*constraints)[i]; 
@@ -238,12 +245,10 @@ Clause* BinaryResolution::generateClause(Clause* queryCl, Literal* queryLit, SLQ
          (!theory->isInterpretedFunction(rT) && !theory->isInterpretedConstant(rT))){
 
         // the unification was between two uninterpreted things that were not ground 
-        res->destroy();
         return 0;
       } 
 
-      (*res)[next] = constraint; 
-      next++;    
+      resLits.push(constraint);
   }
   }
   for(unsigned i=0;i<clength;i++) {
@@ -255,7 +260,6 @@ Clause* BinaryResolution::generateClause(Clause* queryCl, Literal* queryLit, SLQ
         if(wlb > weightLimit) {
           RSTAT_CTR_INC("binary resolutions skipped for weight limit while building clause");
           env.statistics->discardedNonRedundantClauses++;
-          res->destroy();
           return 0;
         }
       }
@@ -268,12 +272,10 @@ Clause* BinaryResolution::generateClause(Clause* queryCl, Literal* queryLit, SLQ
             (ls->isPositiveForSelection(newLit)    // strict maximimality for positive literals
                 && (o == Ordering::GREATER_EQ || o == Ordering::EQUAL))) { // where is GREATER_EQ ever coming from?
           env.statistics->inferencesBlockedForOrderingAftercheck++;
-          res->destroy();
           return 0;
         }
       }
-      (*res)[next] = newLit;
-      next++;
+      resLits.push(newLit);
     }
   }
 
@@ -292,7 +294,6 @@ Clause* BinaryResolution::generateClause(Clause* queryCl, Literal* queryLit, SLQ
         if(wlb > weightLimit) {
           RSTAT_CTR_INC("binary resolutions skipped for weight limit while building clause");
           env.statistics->discardedNonRedundantClauses++;
-          res->destroy();
           return 0;
         }
       }
@@ -305,15 +306,21 @@ Clause* BinaryResolution::generateClause(Clause* queryCl, Literal* queryLit, SLQ
             (ls->isPositiveForSelection(newLit)   // strict maximimality for positive literals
                 && (o == Ordering::GREATER_EQ || o == Ordering::EQUAL))) { // where is GREATER_EQ ever coming from?
           env.statistics->inferencesBlockedForOrderingAftercheck++;
-          res->destroy();
           return 0;
         }
       }
 
-      (*res)[next] = newLit;
-      next++;
+      resLits.push(newLit);
     }
   }
+  ASS_EQ(resLits.size(), clength+dlength-2+conlength);
+
+  Inference* inf = new Inference2((withConstraints?Inference::CONSTRAINED_RESOLUTION:Inference::RESOLUTION), 
+                                  queryCl, qr.clause);
+  Unit::InputType inpType = (Unit::InputType)
+  	Int::max(queryCl->inputType(), qr.clause->inputType());
+
+  Clause* res = Clause::fromStack(resLits, inpType, inf);
 
   res->setAge(newAge);
   if(withConstraints){
@@ -351,4 +358,37 @@ ClauseIterator BinaryResolution::generateClauses(Clause* premise)
   return pvi(it5);
 }
 
+/**
+ * Perform the same inferences as generateClauses, in the same order,
+ * passing each conclusion directly to @b consumer
+ */
+void BinaryResolution::generateClausesInto(Clause* premise, GeneratedClauseConsumer& consumer)
+{
+  CALL("BinaryResolution::generateClausesInto");
+
+  TimeCounter tc(TC_RESOLUTION);
+
+  Limits* limits = _salg->getLimits();
+  Ordering* ord = (getOptions().literalMaximalityAftercheck() && _salg->getLiteralSelector().isBGComplete()) ?
+      &_salg->getOrdering() : 0;
+  LiteralSelector* ls = &_salg->getLiteralSelector();
+
+  unsigned selCnt = premise->numSelected();
+  for(unsigned i=0;i<selCnt;i++) {
+    Literal* lit = (*premise)[i];
+    if(lit->isEquality()) {
+      //Binary resolution is not performed with equality literals
+      continue;
+    }
+    SLQueryResultIterator unifs = _unificationWithAbstraction ?
+        _index->getUnificationsWithConstraints(lit, true) : _index->getUnifications(lit, true);
+    while(unifs.hasNext()) {
+      Clause* res = generateClause(premise, lit, unifs.next(), getOptions(), limits, ord, ls);
+      if(res) {
+        consumer.consume(res);
+      }
+    }
+  }
+}
+
 }
@@ -51,6 +51,7 @@ public:
 
   static Clause* generateClause(Clause* queryCl, Literal* queryLit, SLQueryResult res, const Options& opts, Limits* limits=0, Ordering* ord=0, LiteralSelector* ls = 0);
   ClauseIterator generateClauses(Clause* premise);
+  void generateClausesInto(Clause* premise, GeneratedClauseConsumer& consumer);
 
 private:
   struct UnificationsFn;
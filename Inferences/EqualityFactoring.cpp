@@ -133,10 +133,11 @@ struct EqualityFactoring::ResultFn
       return 0;
     }
 
-    Inference* inf = new Inference1(Inference::EQUALITY_FACTORING, _cl);
-    Clause* res = new(_cLen) Clause(_cLen, _cl->inputType(), inf);
+    // the clause and its inference are only created once the conclusion survives the aftercheck
+    static LiteralStack resLits;
+    resLits.reset();
 
-    (*res)[0]=Literal::createEquality(false, sRHSS, fRHSS, srt);
+    resLits.push(Literal::createEquality(false, sRHSS, fRHSS, srt));
 
     Literal* sLitAfter = 0;
     if (_afterCheck && _cl->numSelected() > 1) {
@@ -144,7 +145,6 @@ struct EqualityFactoring::ResultFn
       sLitAfter = subst.apply(sLit, 0);
     }
 
-    unsigned next = 1;
     for(unsigned i=0;i<_cLen;i++) {
       Literal* curr=(*_cl)[i];
       if(curr!=sLit) {
@@ -154,15 +154,17 @@ struct EqualityFactoring::ResultFn
           TimeCounter tc(TC_LITERAL_ORDER_AFTERCHECK);
           if (i < _cl->numSelected() && _ordering.compare(currAfter,sLitAfter) == Ordering::GREATER) {
             env.statistics->inferencesBlockedForOrderingAftercheck++;
-            res->destroy();
             return 0;
           }
         }
 
-        (*res)[next++] = currAfter;
+        resLits.push(currAfter);
       }
     }
-    ASS_EQ(next,_cLen);
+    ASS_EQ(resLits.size(),_cLen);
+
+    Inference* inf = new Inference1(Inference::EQUALITY_FACTORING, _cl);
+    Clause* res = Clause::fromStack(resLits, _cl->inputType(), inf);
 
     res->setAge(_cl->age()+1);
     env.statistics->equalityFactoring++;
@@ -201,4 +203,43 @@ ClauseIterator EqualityFactoring::generateClauses(Clause* premise)
   return pvi( it6 );
 }
 
+void EqualityFactoring::generateClausesInto(Clause* premise, GeneratedClauseConsumer& consumer)
+{
+  CALL("EqualityFactoring::generateClausesInto");
+
+  if(premise->length()<=1) {
+    return;
+  }
+  ASS(premise->numSelected()>0);
+
+  ResultFn resultFn(premise,
+      getOptions().literalMaximalityAftercheck() && _salg->getLiteralSelector().isBGComplete(), _salg->getOrdering());
+
+  unsigned selCnt = premise->numSelected();
+  unsigned len = premise->length();
+  for(unsigned i=0;i<selCnt;i++) {
+    Literal* sLit = (*premise)[i];
+    if(!IsPositiveEqualityFn()(sLit)) {
+      continue;
+    }
+    TermIterator lhsIt = EqHelper::getLHSIterator(sLit, _salg->getOrdering());
+    while(lhsIt.hasNext()) {
+      TermList sLHS = lhsIt.next();
+      IsDifferentPositiveEqualityFn isOtherEquality(sLit);
+      for(unsigned j=0;j<len;j++) {
+        Literal* fLit = (*premise)[j];
+        if(!isOtherEquality(fLit)) {
+          continue;
+        }
+        for(unsigned k=0;k<2;k++) {
+          Clause* res = resultFn(make_pair(make_pair(sLit, sLHS), make_pair(fLit, *fLit->nthArgument(k))));
+          if(res) {
+            consumer.consume(res);
+          }
+        }
+      }
+    }
+  }
+}
+
 }
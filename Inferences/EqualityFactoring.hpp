@@ -43,6 +43,7 @@ public:
   USE_ALLOCATOR(EqualityFactoring);
 
   ClauseIterator generateClauses(Clause* premise);
+  void generateClausesInto(Clause* premise, GeneratedClauseConsumer& consumer);
 private:
   struct IsPositiveEqualityFn;
   struct IsDifferentPositiveEqualityFn;
@@ -145,6 +145,32 @@ ClauseIterator EqualityResolution::generateClauses(Clause* premise)
   return pvi( it4 );
 }
 
+void EqualityResolution::generateClausesInto(Clause* premise, GeneratedClauseConsumer& consumer)
+{
+  CALL("EqualityResolution::generateClausesInto");
+
+  if(premise->isEmpty()) {
+    return;
+  }
+  ASS(premise->numSelected()>0);
+
+  ResultFn resultFn(premise,
+      getOptions().literalMaximalityAftercheck() && _salg->getLiteralSelector().isBGComplete(),
+      &_salg->getOrdering());
+
+  unsigned selCnt = premise->numSelected();
+  for(unsigned i=0;i<selCnt;i++) {
+    Literal* lit = (*premise)[i];
+    if(!IsNegativeEqualityFn()(lit)) {
+      continue;
+    }
+    Clause* res = resultFn(lit);
+    if(res) {
+      consumer.consume(res);
+    }
+  }
+}
+
 /**
  * @c toResolve must be an negative equality. If it is resolvable,
  * resolve it and return the resulting clause. If it is not resolvable,
@@ -43,6 +43,7 @@ public:
   USE_ALLOCATOR(EqualityResolution);
 
   ClauseIterator generateClauses(Clause* premise);
+  void generateClausesInto(Clause* premise, GeneratedClauseConsumer& consumer);
   static Clause* tryResolveEquality(Clause* cl, Literal* toResolve);
 private:
   struct ResultFn;
@@ -67,6 +67,9 @@ void ForwardDemodulation::attach(SaturationAlgorithm* salg)
 	  _salg->getIndexManager()->request(DEMODULATION_LHS_SUBST_TREE) );
 
   _preorderedOnly=getOptions().forwardDemodulation()==Options::Demodulation::PREORDERED;
+  _useNormalFormCache=getOptions().demodulationNormalFormCache();
+  _normalFormsGeneration=_index->generation();
+  _normalForms.reset();
 }
 
 void ForwardDemodulation::detach()
@@ -93,6 +96,15 @@ bool ForwardDemodulation::perform(Clause* cl, Clause*& replacement, ClauseIterat
   static DHSet<TermList> attempted;
   attempted.reset();
 
+  if(_useNormalFormCache) {
+    if(_normalFormsGeneration!=_index->generation()) {
+      //new rewrite rules were added, so the cached terms may be reducible now
+      _normalForms.reset();
+      _normalFormsGeneration=_index->generation();
+    }
+    _contextDependent.reset();
+  }
+
   unsigned cLen=cl->length();
   for(unsigned li=0;li<cLen;li++) {
     Literal* lit=(*cl)[li];
@@ -107,6 +119,11 @@ bool ForwardDemodulation::perform(Clause* cl, Clause*& replacement, ClauseIterat
 	nvi.right();
 	continue;
       }
+      if(_useNormalFormCache && _normalForms.contains(trm.term())) {
+	env.statistics->forwardDemodulationNormalFormHits++;
+	nvi.right();
+	continue;
+      }
 
       unsigned querySort = SortHelper::getTermSort(trm, lit);
 
@@ -119,6 +136,9 @@ bool ForwardDemodulation::perform(Clause* cl, Clause*& replacement, ClauseIterat
 	ASS_EQ(qr.clause->length(),1);
 
 	if(!ColorHelper::compatible(cl->color(), qr.clause->color())) {
+	  if(_useNormalFormCache) {
+	    _contextDependent.insert(trm.term());
+	  }
 	  continue;
 	}
 
@@ -184,6 +204,9 @@ bool ForwardDemodulation::perform(Clause* cl, Clause*& replacement, ClauseIterat
 	      //---------------------
 	      //     t = t1 \/ C
 	      //where t > t1 and s = t > C
+	      if(_useNormalFormCache) {
+		_contextDependent.insert(trm.term());
+	      }
 	      continue;
 	    }
 	  }
@@ -224,7 +247,45 @@ bool ForwardDemodulation::perform(Clause* cl, Clause*& replacement, ClauseIterat
     }
   }
 
+  if(_useNormalFormCache) {
+    //all non-variable subterms of the clause were attempted, so we can
+    //remember those that are irreducible regardless of the context
+    for(unsigned li=0;li<cLen;li++) {
+      Literal* lit=(*cl)[li];
+      for(TermList* arg=lit->args(); arg->isNonEmpty(); arg=arg->next()) {
+	if(arg->isTerm()) {
+	  markNormalForms(arg->term());
+	}
+      }
+    }
+  }
+
   return false;
 }
 
+/**
+ * Insert into @b _normalForms the term @b t and its subterms, provided that
+ * they and all their subterms were attempted in the current call to
+ * @b perform and could not be rewritten for reasons independent of the
+ * context. Return true iff @b t itself was inserted.
+ */
+bool ForwardDemodulation::markNormalForms(Term* t)
+{
+  CALL("ForwardDemodulation::markNormalForms");
+
+  if(_normalForms.contains(t)) {
+    return true;
+  }
+  bool res=!_contextDependent.contains(t);
+  for(TermList* arg=t->args(); arg->isNonEmpty(); arg=arg->next()) {
+    if(arg->isTerm() && !markNormalForms(arg->term())) {
+      res=false;
+    }
+  }
+  if(res) {
+    _normalForms.insert(t);
+  }
+  return res;
+}
+
 }
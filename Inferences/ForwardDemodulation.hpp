@@ -26,6 +26,9 @@
 #define __ForwardDemodulation__
 
 #include "Forwards.hpp"
+
+#include "Lib/DHSet.hpp"
+
 #include "Indexing/TermIndex.hpp"
 
 #include "InferenceEngine.hpp"
@@ -48,8 +51,21 @@ public:
   void detach() override;
   bool perform(Clause* cl, Clause*& replacement, ClauseIterator& premises) override;
 private:
+  bool markNormalForms(Term* t);
+
   bool _preorderedOnly;
   DemodulationLHSIndex* _index;
+
+  /**
+   * Shared terms that, together with all their subterms, cannot be
+   * rewritten by the index in any context. Valid only while the index
+   * generation equals @b _normalFormsGeneration.
+   */
+  DHSet<Term*> _normalForms;
+  /** Shared terms whose rewriting failed only for context dependent reasons */
+  DHSet<Term*> _contextDependent;
+  unsigned _normalFormsGeneration;
+  bool _useNormalFormCache;
 };
 
 };
@@ -37,6 +37,7 @@
 #include "Kernel/ColorHelper.hpp"
 
 #include "Indexing/Index.hpp"
+#include "Indexing/ClauseFeatureIndex.hpp"
 #include "Indexing/LiteralIndex.hpp"
 #include "Indexing/LiteralMiniIndex.hpp"
 #include "Indexing/IndexManager.hpp"
@@ -65,6 +66,10 @@ void ForwardSubsumptionAndResolution::attach(SaturationAlgorithm* salg)
 	  _salg->getIndexManager()->request(SIMPLIFYING_UNIT_CLAUSE_SUBST_TREE) );
   _fwIndex=static_cast<FwSubsSimplifyingLiteralIndex*>(
 	  _salg->getIndexManager()->request(FW_SUBSUMPTION_SUBST_TREE) );
+  if(getOptions().subsumptionFeatureFilter()) {
+    _featureIndex=static_cast<ClauseFeatureIndex*>(
+	  _salg->getIndexManager()->request(SUBSUMPTION_FEATURE_INDEX) );
+  }
 }
 
 void ForwardSubsumptionAndResolution::detach()
@@ -74,6 +79,10 @@ void ForwardSubsumptionAndResolution::detach()
   _fwIndex=0;
   _salg->getIndexManager()->release(SIMPLIFYING_UNIT_CLAUSE_SUBST_TREE);
   _salg->getIndexManager()->release(FW_SUBSUMPTION_SUBST_TREE);
+  if(_featureIndex) {
+    _featureIndex=0;
+    _salg->getIndexManager()->release(SUBSUMPTION_FEATURE_INDEX);
+  }
   ForwardSimplificationEngine::detach();
 }
 
@@ -289,6 +298,11 @@ bool ForwardSubsumptionAndResolution::perform(Clause* cl, Clause*& replacement,
   {
   LiteralMiniIndex miniIndex(cl);
 
+  ClauseFeatures features;
+  if(_featureIndex) {
+    features=ClauseFeatures(cl);
+  }
+
   for(unsigned li=0;li<clen;li++) {
     SLQueryResultIterator rit=_fwIndex->getGeneralizations( (*cl)[li], false, false);
     while(rit.hasNext()) {
@@ -312,6 +326,13 @@ bool ForwardSubsumptionAndResolution::perform(Clause* cl, Clause*& replacement,
 	continue;
       }
 
+      if(_featureIndex && !_featureIndex->maySubsume(mcl, features)) {
+	//The clause cannot subsume, but its matches stay in cmStore,
+	//as the clause may still be used for subsumption resolution
+	env.statistics->subsumptionFeatureRejections++;
+	continue;
+      }
+
       if(MLMatcher::canBeMatched(mcl,cl,cms->_matches,0) && ColorHelper::compatible(cl->color(), mcl->color())) {
         premises = pvi( getSingletonIterator(mcl) );
         env.statistics->forwardSubsumed++;
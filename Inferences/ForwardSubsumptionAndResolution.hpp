@@ -43,7 +43,7 @@ public:
   USE_ALLOCATOR(ForwardSubsumptionAndResolution);
 
   ForwardSubsumptionAndResolution(bool subsumptionResolution=true)
-  : _subsumptionResolution(subsumptionResolution) {}
+  : _featureIndex(0), _subsumptionResolution(subsumptionResolution) {}
 
   void attach(SaturationAlgorithm* salg) override;
   void detach() override;
@@ -54,6 +54,8 @@ private:
   /** Simplification unit index */
   UnitClauseLiteralIndex* _unitIndex;
   FwSubsSimplifyingLiteralIndex* _fwIndex;
+  /** Clause features of the simplifying clauses, zero if the filter is off */
+  ClauseFeatureIndex* _featureIndex;
 
   bool _subsumptionResolution;
 };
@@ -24,6 +24,7 @@
 #include "Lib/Environment.hpp"
 #include "Lib/Random.hpp"
 #include "Lib/DArray.hpp"
+#include "Lib/DHSet.hpp"
 #include "Lib/List.hpp"
 #include "Lib/Metaiterators.hpp"
 
@@ -61,6 +62,61 @@ const Options& InferenceEngine::getOptions() const
   return _salg->getOptions();
 }
 
+void GeneratingInferenceEngine::generateClausesInto(Clause* premise, GeneratedClauseConsumer& consumer)
+{
+  CALL("GeneratingInferenceEngine::generateClausesInto");
+
+  ClauseIterator it = generateClauses(premise);
+  while(it.hasNext()) {
+    consumer.consume(it.next());
+  }
+}
+
+/**
+ * Perform backward simplification with all clauses in @b premises
+ *
+ * All records in @b simplifications have the @b premise field set.
+ * The records are evaluated before this function returns, so the
+ * caller is free to modify the indexes while traversing them. A clause
+ * is reported for removal at most once, and a premise that was itself
+ * simplified by an earlier member of the batch is not used any more.
+ *
+ * Descendant classes can override this function to share the index
+ * traversal between the premises.
+ */
+void BackwardSimplificationEngine::performBatch(ClauseStack& premises, BwSimplificationRecordIterator& simplifications)
+{
+  CALL("BackwardSimplificationEngine::performBatch");
+
+  static Stack<BwSimplificationRecord> records;
+  static DHSet<Clause*> removed;
+  records.reset();
+  removed.reset();
+
+  ClauseStack::Iterator pit(premises);
+  while(pit.hasNext()) {
+    Clause* premise=pit.next();
+    if(removed.contains(premise)) {
+      continue;
+    }
+    BwSimplificationRecordIterator sit;
+    perform(premise, sit);
+    while(sit.hasNext()) {
+      BwSimplificationRecord srec=sit.next();
+      if(!removed.insert(srec.toRemove)) {
+        //the clause was already simplified by an earlier premise of the batch
+        if(srec.replacement) {
+          srec.replacement->destroyIfUnnecessary();
+        }
+        continue;
+      }
+      srec.premise=premise;
+      records.push(srec);
+    }
+  }
+  simplifications=getPersistentIterator(Stack<BwSimplificationRecord>::Iterator(records));
+}
+
 CompositeISE::~CompositeISE()
 {
   ISList::destroyWithDeletion(_inners);
@@ -172,6 +228,15 @@ ClauseIterator CompositeGIE::generateClauses(Clause* premise)
   return pvi( getFlattenedIterator(
 	  getMappingIterator(GIList::Iterator(_inners), GeneratingFunctor(premise))) );
 }
+void CompositeGIE::generateClausesInto(Clause* premise, GeneratedClauseConsumer& consumer)
+{
+  CALL("CompositeGIE::generateClausesInto");
+
+  GIList::Iterator eit(_inners);
+  while(eit.hasNext()) {
+    eit.next()->generateClausesInto(premise, consumer);
+  }
+}
 void CompositeGIE::attach(SaturationAlgorithm* salg)
 {
   GeneratingInferenceEngine::attach(salg);
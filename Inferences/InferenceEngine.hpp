@@ -98,11 +98,31 @@ protected:
 //  ClauseIterator premises;
 //};
 
+/**
+ * Receiver of the clauses produced by GeneratingInferenceEngine::generateClausesInto
+ */
+class GeneratedClauseConsumer
+{
+public:
+  virtual ~GeneratedClauseConsumer() {}
+  virtual void consume(Clause* cl) = 0;
+};
+
 class GeneratingInferenceEngine
 : public InferenceEngine
 {
 public:
   virtual ClauseIterator generateClauses(Clause* premise) = 0;
+
+  /**
+   * Pass the clauses generated from @b premise to @b consumer, in the order
+   * in which they would be returned by generateClauses().
+   *
+   * The default implementation drains generateClauses(). Engines of
+   * the main rules override it so that their conclusions are pushed
+   * without building a chain of iterators.
+   */
+  virtual void generateClausesInto(Clause* premise, GeneratedClauseConsumer& consumer);
 };
 
 class ImmediateSimplificationEngine
@@ -149,12 +169,20 @@ struct BwSimplificationRecord
 {
   BwSimplificationRecord() {}
   BwSimplificationRecord(Clause* toRemove)
-  : toRemove(toRemove), replacement(0) {}
+  : toRemove(toRemove), replacement(0), premise(0) {}
   BwSimplificationRecord(Clause* toRemove, Clause* replacement)
-  : toRemove(toRemove), replacement(replacement) {}
+  : toRemove(toRemove), replacement(replacement), premise(0) {}
+  BwSimplificationRecord(Clause* toRemove, Clause* replacement, Clause* premise)
+  : toRemove(toRemove), replacement(replacement), premise(premise) {}
 
   Clause* toRemove;
   Clause* replacement;
+  /**
+   * The clause that justifies the simplification. Set only by
+   * @b BackwardSimplificationEngine::performBatch, for a single premise
+   * simplification it is the premise passed to the @b perform function.
+   */
+  Clause* premise;
 };
 typedef VirtualIterator<BwSimplificationRecord> BwSimplificationRecordIterator;
 
@@ -170,6 +198,8 @@ public:
    * the time of call to this method.
    */
   virtual void perform(Clause* premise, BwSimplificationRecordIterator& simplifications) = 0;
+
+  virtual void performBatch(ClauseStack& premises, BwSimplificationRecordIterator& simplifications);
 };
 
 
@@ -260,6 +290,7 @@ public:
   virtual ~CompositeGIE();
   void addFront(GeneratingInferenceEngine* fse);
   ClauseIterator generateClauses(Clause* premise);
+  void generateClausesInto(Clause* premise, GeneratedClauseConsumer& consumer);
   void attach(SaturationAlgorithm* salg);
   void detach();
 private:
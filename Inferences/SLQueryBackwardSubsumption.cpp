@@ -38,6 +38,7 @@
 #include "Kernel/Term.hpp"
 #include "Kernel/ColorHelper.hpp"
 
+#include "Indexing/ClauseFeatureIndex.hpp"
 #include "Indexing/Index.hpp"
 #include "Indexing/LiteralIndex.hpp"
 #include "Indexing/IndexManager.hpp"
@@ -68,6 +69,10 @@ void SLQueryBackwardSubsumption::attach(SaturationAlgorithm* salg)
   BackwardSimplificationEngine::attach(salg);
   _index=static_cast<SimplifyingLiteralIndex*>(
 	  _salg->getIndexManager()->request(SIMPLIFYING_SUBST_TREE) );
+  if(getOptions().subsumptionFeatureFilter()) {
+    _featureIndex=static_cast<ClauseFeatureIndex*>(
+	  _salg->getIndexManager()->request(SUBSUMPTION_FEATURE_INDEX) );
+  }
 }
 
 void SLQueryBackwardSubsumption::detach()
@@ -75,6 +80,10 @@ void SLQueryBackwardSubsumption::detach()
   CALL("SLQueryBackwardSubsumption::detach");
   _index=0;
   _salg->getIndexManager()->release(SIMPLIFYING_SUBST_TREE);
+  if(_featureIndex) {
+    _featureIndex=0;
+    _salg->getIndexManager()->release(SUBSUMPTION_FEATURE_INDEX);
+  }
   BackwardSimplificationEngine::detach();
 }
 
@@ -168,6 +177,11 @@ void SLQueryBackwardSubsumption::perform(Clause* cl,
   static DHSet<Clause*> checkedClauses;
   checkedClauses.reset();
 
+  ClauseFeatures features;
+  if(_featureIndex) {
+    features=ClauseFeatures(cl);
+  }
+
   SLQueryResultIterator rit=_index->getInstances( (*cl)[lmIndex], false, false);
   while(rit.hasNext()) {
     SLQueryResult qr=rit.next();
@@ -182,6 +196,11 @@ void SLQueryBackwardSubsumption::perform(Clause* cl,
       continue;
     }
 
+    if(_featureIndex && !_featureIndex->maySubsume(features, icl)) {
+      env.statistics->subsumptionFeatureRejections++;
+      continue;
+    }
+
     RSTAT_CTR_INC("bs1 0 candidates");
 
     //here we pick one literal header of the base clause and make sure that
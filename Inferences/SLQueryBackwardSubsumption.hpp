@@ -38,7 +38,7 @@ public:
   CLASS_NAME(SLQueryBackwardSubsumption);
   USE_ALLOCATOR(SLQueryBackwardSubsumption);
 
-  SLQueryBackwardSubsumption(bool byUnitsOnly) : _byUnitsOnly(byUnitsOnly), _index(0) {}
+  SLQueryBackwardSubsumption(bool byUnitsOnly) : _byUnitsOnly(byUnitsOnly), _index(0), _featureIndex(0) {}
 
   /**
    * Create SLQueryBackwardSubsumption rule with explicitely provided index,
@@ -47,7 +47,7 @@ public:
    * For objects created by this constructor, methods  @c attach()
    * and @c detach() must not be called.
    */
-  SLQueryBackwardSubsumption(SimplifyingLiteralIndex* index, bool byUnitsOnly=false) : _byUnitsOnly(byUnitsOnly), _index(index) {}
+  SLQueryBackwardSubsumption(SimplifyingLiteralIndex* index, bool byUnitsOnly=false) : _byUnitsOnly(byUnitsOnly), _index(index), _featureIndex(0) {}
 
   void attach(SaturationAlgorithm* salg);
   void detach();
@@ -59,6 +59,8 @@ private:
 
   bool _byUnitsOnly;
   SimplifyingLiteralIndex* _index;
+  /** Clause features of the simplifying clauses, zero if the filter is off */
+  ClauseFeatureIndex* _featureIndex;
 };
 
 };
@@ -227,6 +227,66 @@ ClauseIterator Superposition::generateClauses(Clause* premise)
   return pvi( it7 );
 }
 
+/**
+ * Perform the same inferences as generateClauses, in the same order, but
+ * traverse the selected literals, their subterms and the index results
+ * directly and pass each conclusion to @b consumer
+ */
+void Superposition::generateClausesInto(Clause* premise, GeneratedClauseConsumer& consumer)
+{
+  CALL("Superposition::generateClausesInto");
+
+  TimeCounter tc(TC_SUPERPOSITION);
+
+  Limits* limits=_salg->getLimits();
+  const Ordering& ord=_salg->getOrdering();
+
+  static bool withConstraints = env.options->unificationWithAbstraction()!=Options::UnificationWithAbstraction::OFF;
+
+  unsigned selCnt=premise->numSelected();
+
+  //Perform forward superposition
+  for(unsigned i=0;i<selCnt;i++) {
+    Literal* rwLit=(*premise)[i];
+    TermIterator rwTerms=EqHelper::getRewritableSubtermIterator(rwLit, ord);
+    while(rwTerms.hasNext()) {
+      TermList rwTerm=rwTerms.next();
+      TermQueryResultIterator unifs=withConstraints ?
+	  _lhsIndex->getUnificationsWithConstraints(rwTerm, true) : _lhsIndex->getUnifications(rwTerm, true);
+      while(unifs.hasNext()) {
+        TermQueryResult qr=unifs.next();
+        Clause* res=performSuperposition(premise, rwLit, rwTerm,
+	    qr.clause, qr.literal, qr.term, qr.substitution, true, limits, qr.constraints);
+        if(res) {
+          consumer.consume(res);
+        }
+      }
+    }
+  }
+
+  //Perform backward superposition
+  for(unsigned i=0;i<selCnt;i++) {
+    Literal* eqLit=(*premise)[i];
+    TermIterator lhsIt=EqHelper::getSuperpositionLHSIterator(eqLit, ord, _salg->getOptions());
+    while(lhsIt.hasNext()) {
+      TermList eqLHS=lhsIt.next();
+      TermQueryResultIterator unifs=withConstraints ?
+	  _subtermIndex->getUnificationsWithConstraints(eqLHS, true) : _subtermIndex->getUnifications(eqLHS, true);
+      while(unifs.hasNext()) {
+        TermQueryResult qr=unifs.next();
+        if(qr.clause==premise) {
+          continue;
+        }
+        Clause* res=performSuperposition(qr.clause, qr.literal, qr.term,
+	    premise, eqLit, eqLHS, qr.substitution, false, limits, qr.constraints);
+        if(res) {
+          consumer.consume(res);
+        }
+      }
+    }
+  }
+}
+
 /**
  * Return true iff superposition of @c eqClause into @c rwClause can be performed
  * with respect to colors of the clauses. If the inference is not possible, based
@@ -523,55 +583,27 @@ Clause* Superposition::performSuperposition(
     return 0;
   }
 
-  unsigned newLength = rwLength+eqLength-1+conLength;
-
-  Inference* inf = new Inference2(hasConstraints ? Inference::  CONSTRAINED_SUPERPOSITION : Inference::SUPERPOSITION, 
-                          rwClause, eqClause);
-  Unit::InputType inpType = (Unit::InputType)
-  	    Int::max(rwClause->inputType(), eqClause->inputType());
-
-  // If proof extra is on let's compute the positions we have performed
-  // superposition on 
-  if(env.options->proofExtra()==Options::ProofExtra::FULL){
-    /*
-    cout << "rwClause " << rwClause->toString() << endl;
-    cout << "eqClause " << eqClause->toString() << endl;
-    cout << "rwLit " << rwLit->toString() << endl;
-    cout << "eqLit " << eqLit->toString() << endl;
-    cout << "rwTerm " << rwTerm.toString() << endl;
-    cout << "eqLHS " << eqLHS.toString() << endl;
-     */
-    //cout << subst->toString() << endl;
-
-    // First find which literal it is in the clause, as selection has occured already
-    // this should remain the same...?
-    vstring rwPlace = Lib::Int::toString(rwClause->getLiteralPosition(rwLit));
-    vstring eqPlace = Lib::Int::toString(eqClause->getLiteralPosition(eqLit));
-
-    vstring rwPos="_";
-    ALWAYS(Inference::positionIn(rwTerm,rwLit,rwPos));
-    vstring eqPos = "("+eqPlace+").2";
-    rwPos = "("+rwPlace+")."+rwPos;
-
-    vstring eqClauseNum = Lib::Int::toString(eqClause->number());
-    vstring rwClauseNum = Lib::Int::toString(rwClause->number());
-
-    vstring extra = eqClauseNum + " into " + rwClauseNum+", unify on "+
-        eqPos+" in "+eqClauseNum+" and "+
-        rwPos+" in "+rwClauseNum;
-
-    //cout << extra << endl;
-    //NOT_IMPLEMENTED;
-
-    inf->setExtra(extra);
+  if(weightLimit!=-1) {
+    // when the substitution knows the weights of the instances, a conclusion over the weight
+    // limit is discarded before any of its other literals gets inserted into the term sharing
+    size_t conclusionWeight = tgtLitS->weight();
+    if(subst->addApplicationWeight(rwClause, rwLit, !eqIsResult, conclusionWeight) &&
+       subst->addApplicationWeight(eqClause, eqLit, eqIsResult, conclusionWeight) &&
+       conclusionWeight > static_cast<size_t>(weightLimit)) {
+      RSTAT_CTR_INC("superpositions skipped for weight limit before constructing other literals");
+      env.statistics->discardedNonRedundantClauses++;
+      return 0;
+    }
   }
 
   bool afterCheck = getOptions().literalMaximalityAftercheck() && _salg->getLiteralSelector().isBGComplete();
 
-  Clause* res = new(newLength) Clause(newLength, inpType, inf);
+  // The literals of the conclusion are collected in a reusable buffer, the clause
+  // and its inference are only created when the conclusion passes all the checks
+  static LiteralStack resLits;
+  resLits.reset();
 
-  (*res)[0] = tgtLitS;
-  int next = 1;
+  resLits.push(tgtLitS);
   int weight=tgtLitS->weight();
   for(unsigned i=0;i<rwLength;i++) {
     Literal* curr=(*rwClause)[i];
@@ -579,7 +611,7 @@ Clause* Superposition::performSuperposition(
       Literal* currAfter = subst->apply(curr, !eqIsResult);
 
       if(EqHelper::isEqTautology(currAfter)) {
-        goto construction_fail;
+        return 0;
       }
 
       if(weightLimit!=-1) {
@@ -587,7 +619,7 @@ Clause* Superposition::performSuperposition(
         if(weight>weightLimit) {
           RSTAT_CTR_INC("superpositions skipped for weight limit while constructing other literals");
           env.statistics->discardedNonRedundantClauses++;
-          goto construction_fail;
+          return 0;
         }
       }
 
@@ -595,11 +627,11 @@ Clause* Superposition::performSuperposition(
         TimeCounter tc(TC_LITERAL_ORDER_AFTERCHECK);
         if (i < rwClause->numSelected() && ordering.compare(currAfter,rwLitS) == Ordering::GREATER) {
           env.statistics->inferencesBlockedForOrderingAftercheck++;
-          goto construction_fail;
+          return 0;
         }
       }
 
-      (*res)[next++] = currAfter;
+      resLits.push(currAfter);
     }
   }
 
@@ -616,14 +648,14 @@ Clause* Superposition::performSuperposition(
         Literal* currAfter = subst->apply(curr, eqIsResult);
 
         if(EqHelper::isEqTautology(currAfter)) {
-          goto construction_fail;
+          return 0;
         }
         if(weightLimit!=-1) {
           weight+=currAfter->weight();
           if(weight>weightLimit) {
             RSTAT_CTR_INC("superpositions skipped for weight limit while constructing other literals");
             env.statistics->discardedNonRedundantClauses++;
-            goto construction_fail;
+            return 0;
           }
         }
 
@@ -634,11 +666,11 @@ Clause* Superposition::performSuperposition(
 
           if (o == Ordering::GREATER || o == Ordering::GREATER_EQ || o == Ordering::EQUAL) { // where is GREATER_EQ ever coming from?
             env.statistics->inferencesBlockedForOrderingAftercheck++;
-            goto construction_fail;
+            return 0;
           }
         }
 
-        (*res)[next++] = currAfter;
+        resLits.push(currAfter);
       }
     }
   }
@@ -659,23 +691,50 @@ Clause* Superposition::performSuperposition(
          (!theory->isInterpretedFunction(rT) && !theory->isInterpretedConstant(rT))){
 
         // the unification was between two uninterpreted things that were not ground 
-        res->destroy();
         return 0;
       }
 
-      (*res)[next] = constraint;
-      next++;   
+      resLits.push(constraint);
     }
   }
 
   if(weightLimit!=-1 && weight>weightLimit) {
     RSTAT_CTR_INC("superpositions skipped for weight limit after the clause was built");
     env.statistics->discardedNonRedundantClauses++;
-    construction_fail:
-    res->destroy();
     return 0;
   }
   ASS(weightLimit==-1 || weight<=weightLimit);
+  ASS_EQ(resLits.size(), rwLength+eqLength-1+conLength);
+
+  Inference* inf = new Inference2(hasConstraints ? Inference::  CONSTRAINED_SUPERPOSITION : Inference::SUPERPOSITION, 
+                          rwClause, eqClause);
+  Unit::InputType inpType = (Unit::InputType)
+  	    Int::max(rwClause->inputType(), eqClause->inputType());
+
+  // If proof extra is on let's compute the positions we have performed
+  // superposition on 
+  if(env.options->proofExtra()==Options::ProofExtra::FULL){
+    // First find which literal it is in the clause, as selection has occured already
+    // this should remain the same...?
+    vstring rwPlace = Lib::Int::toString(rwClause->getLiteralPosition(rwLit));
+    vstring eqPlace = Lib::Int::toString(eqClause->getLiteralPosition(eqLit));
+
+    vstring rwPos="_";
+    ALWAYS(Inference::positionIn(rwTerm,rwLit,rwPos));
+    vstring eqPos = "("+eqPlace+").2";
+    rwPos = "("+rwPlace+")."+rwPos;
+
+    vstring eqClauseNum = Lib::Int::toString(eqClause->number());
+    vstring rwClauseNum = Lib::Int::toString(rwClause->number());
+
+    vstring extra = eqClauseNum + " into " + rwClauseNum+", unify on "+
+        eqPos+" in "+eqClauseNum+" and "+
+        rwPos+" in "+rwClauseNum;
+
+    inf->setExtra(extra);
+  }
+
+  Clause* res = Clause::fromStack(resLits, inpType, inf);
 
   res->setAge(newAge);
 
@@ -47,7 +47,7 @@ public:
   void detach();
 
   ClauseIterator generateClauses(Clause* premise);
-
+  void generateClausesInto(Clause* premise, GeneratedClauseConsumer& consumer);
 
 private:
   Clause* performSuperposition(
@@ -595,6 +595,22 @@ unsigned Clause::getNumeralWeight()
   return res;
 } // getNumeralWeight
 
+/**
+ * Return the weight of the clause with symbols weighted by the symbol
+ * weight table, see Term::symbolWeight(). As the weights of literals are
+ * cached, this does not traverse the literals.
+ */
+unsigned Clause::symbolWeight() const
+{
+  CALL("Clause::symbolWeight");
+
+  unsigned res=0;
+  for (unsigned i=0;i<_length;i++) {
+    res+=_literals[i]->symbolWeight();
+  }
+  return res;
+} // Clause::symbolWeight
+
 /**
  * Return effective weight of the clause (i.e. weight multiplied
  * by the nongoal weight coefficient, if applicable)
@@ -332,6 +332,7 @@ public:
 
   unsigned splitWeight() const;
   unsigned getNumeralWeight();
+  unsigned symbolWeight() const;
   float getEffectiveWeight(const Shell::Options& opt);
 
   void collectVars(DHSet<unsigned>& acc);
@@ -385,6 +385,11 @@ Ordering::Result KBO::compare(TermList tl1, TermList tl2) const
   ASS(tl1.isTerm());
   ASS(tl2.isTerm());
 
+  Result res;
+  if(tryGetCachedResult(tl1,tl2,res)) {
+    return res;
+  }
+
   Term* t1=tl1.term();
   Term* t2=tl2.term();
 
@@ -402,10 +407,11 @@ Ordering::Result KBO::compare(TermList tl1, TermList tl2) const
     state->traverse(tl1,1);
     state->traverse(tl2,-1);
   }
-  Result res=state->result(t1,t2);
+  res=state->result(t1,t2);
 #if VDEBUG
   _state=state;
 #endif
+  cacheResult(tl1,tl2,res);
   return res;
 }
 
@@ -82,7 +82,17 @@ Ordering::Result LPO::compare(TermList tl1, TermList tl2) const
     return tl2.containsSubterm(tl1) ? LESS : INCOMPARABLE;
   }
   ASS(tl1.isTerm());
-  return clpo(tl1.term(), tl2);
+  if(tl2.isOrdinaryVar()) {
+    return clpo(tl1.term(), tl2);
+  }
+
+  Result res;
+  if(tryGetCachedResult(tl1,tl2,res)) {
+    return res;
+  }
+  res=clpo(tl1.term(), tl2);
+  cacheResult(tl1,tl2,res);
+  return res;
 }
 
 Ordering::Result LPO::clpo(Term* t1, TermList tl2) const
@@ -186,6 +186,58 @@ VirtualIterator<void> LookaheadLiteralSelector::getGeneraingInferenceIterator(Li
   return pvi( getFlattenedIterator(GenIteratorIterator(lit, *this)) );
 }
 
+/**
+ * Return an estimate of the number of inferences that can be performed
+ * with @b lit selected. The estimate counts the index entries with the
+ * same top symbol as the terms and literals that would be unified, which
+ * the indices maintain as clauses are inserted and removed, so no
+ * unifiers are enumerated.
+ */
+size_t LookaheadLiteralSelector::estimateGeneratingInferences(Literal* lit)
+{
+  CALL("LookaheadLiteralSelector::estimateGeneratingInferences");
+
+  SaturationAlgorithm* salg=SaturationAlgorithm::tryGetInstance();
+  if(!salg) {
+    //there are no generating inferences yet
+    return 0;
+  }
+  IndexManager* imgr=salg->getIndexManager();
+  ASS(imgr);
+
+  size_t res=0;
+
+  //resolution
+  res+=imgr->getGeneratingLiteralIndexingStructure()->getUnificationCountEstimate(lit,true);
+
+  //backward superposition
+  if(imgr->contains(SUPERPOSITION_SUBTERM_SUBST_TREE)) {
+    TermIndex* bsi=static_cast<TermIndex*>(imgr->get(SUPERPOSITION_SUBTERM_SUBST_TREE));
+    TermIterator lhsi=EqHelper::getLHSIterator(lit, _ord);
+    while(lhsi.hasNext()) {
+      res+=bsi->getUnificationCountEstimate(lhsi.next());
+    }
+  }
+
+  //forward superposition
+  if(imgr->contains(SUPERPOSITION_LHS_SUBST_TREE)) {
+    TermIndex* fsi=static_cast<TermIndex*>(imgr->get(SUPERPOSITION_LHS_SUBST_TREE));
+    TermIterator rsti=EqHelper::getRewritableSubtermIterator(lit, _ord);
+    while(rsti.hasNext()) {
+      res+=fsi->getUnificationCountEstimate(rsti.next());
+    }
+  }
+
+  //equality resolution
+  if(lit->isNegative() && lit->isEquality()) {
+    RobSubstitution rs;
+    if(rs.unify(*lit->nthArgument(0), 0, *lit->nthArgument(1), 0)) {
+      res++;
+    }
+  }
+  return res;
+}
+
 /**
  * Return the literal from the @b lits array (of length @b cnt) that
  * is the best to be selected. This selection is done irregardless any
@@ -196,25 +248,48 @@ Literal* LookaheadLiteralSelector::pickTheBest(Literal** lits, unsigned cnt)
   CALL("LookaheadLiteralSelector::pickTheBest");
   ASS_G(cnt,1); //special cases are handled elsewhere
 
-  static DArray<VirtualIterator<void> > runifs; //resolution unification iterators
-  runifs.ensure(cnt);
-
-  for(unsigned i=0;i<cnt;i++) {
-    runifs[i]=getGeneraingInferenceIterator(lits[i]);
-  }
-
   static Stack<Literal*> candidates;
   candidates.reset();
-  do {
-    for(unsigned i=0;i<cnt;i++) {
-      if(runifs[i].hasNext()) {
-	runifs[i].next();
+
+  if(_estimateInferences) {
+    //as with the enumeration below, the candidates are the literals
+    //with the least number of inferences, in the order of @b lits
+    size_t best=estimateGeneratingInferences(lits[0]);
+    candidates.push(lits[0]);
+    for(unsigned i=1;i<cnt;i++) {
+      size_t estimate=estimateGeneratingInferences(lits[i]);
+      if(estimate<best) {
+	best=estimate;
+	candidates.reset();
       }
-      else {
+      if(estimate==best) {
 	candidates.push(lits[i]);
       }
     }
-  } while(candidates.isEmpty());
+  }
+  else {
+    static DArray<VirtualIterator<void> > runifs; //resolution unification iterators
+    runifs.ensure(cnt);
+
+    for(unsigned i=0;i<cnt;i++) {
+      runifs[i]=getGeneraingInferenceIterator(lits[i]);
+    }
+
+    do {
+      for(unsigned i=0;i<cnt;i++) {
+	if(runifs[i].hasNext()) {
+	  runifs[i].next();
+	}
+	else {
+	  candidates.push(lits[i]);
+	}
+      }
+    } while(candidates.isEmpty());
+
+    for(unsigned i=0;i<cnt;i++) {
+      runifs[i].drop(); //release the iterators
+    }
+  }
 
   using namespace LiteralComparators;
   typedef Composite<ColoredFirst,
@@ -232,10 +307,6 @@ Literal* LookaheadLiteralSelector::pickTheBest(Literal** lits, unsigned cnt)
       }
     }
   }
-
-  for(unsigned i=0;i<cnt;i++) {
-    runifs[i].drop(); //release the iterators
-  }
   return res;
 }
 
@@ -38,7 +38,8 @@ public:
   USE_ALLOCATOR(LookaheadLiteralSelector);
   
   LookaheadLiteralSelector(bool completeSelection, const Ordering& ordering, const Options& options)
-  : LiteralSelector(ordering, options), _completeSelection(completeSelection) 
+  : LiteralSelector(ordering, options), _completeSelection(completeSelection),
+    _estimateInferences(options.lookaheadEstimate())
   {
     _delay = options.lookaheadDelay();
     _skipped = 0;
@@ -52,10 +53,13 @@ private:
   Literal* pickTheBest(Literal** lits, unsigned cnt);
   void removeVariants(LiteralStack& lits);
   VirtualIterator<void> getGeneraingInferenceIterator(Literal* lit);
+  size_t estimateGeneratingInferences(Literal* lit);
 
   struct GenIteratorIterator;
 
   bool _completeSelection;
+  /** estimate the numbers of inferences from index sizes instead of enumerating them */
+  bool _estimateInferences;
   LiteralSelector* _startupSelector;
   int _delay;
   int _skipped;
@@ -38,6 +38,7 @@
 
 #include "Shell/Options.hpp"
 #include "Shell/Property.hpp"
+#include "Shell/Statistics.hpp"
 
 #include "LPO.hpp"
 #include "KBO.hpp"
@@ -58,6 +59,7 @@ using namespace Kernel;
 OrderingSP Ordering::s_globalOrdering;
 
 Ordering::Ordering()
+: _resultCacheMask(0)
 {
   CALL("Ordering::Ordering");
 
@@ -116,6 +118,92 @@ Ordering* Ordering::tryGetGlobalOrdering()
   }
 }
 
+/**
+ * Enable caching of comparisons between shared terms in a table of
+ * at least @b capacity entries. If @b capacity is zero, no cache is used.
+ */
+void Ordering::initResultCache(unsigned capacity)
+{
+  CALL("Ordering::initResultCache");
+
+  if(!capacity) {
+    return;
+  }
+  size_t size=1;
+  while(size<capacity) {
+    size*=2;
+  }
+  _resultCache.ensure(size);
+  for(size_t i=0;i<size;i++) {
+    _resultCache[i].t1=0;
+  }
+  _resultCacheMask=size-1;
+}
+
+/**
+ * Return the index of the cache entry for the comparison of terms with
+ * contents @b c1 and @b c2. The callers order the pair by content, so that
+ * both ways of comparing two terms share an entry.
+ */
+static size_t resultCacheIndex(size_t c1, size_t c2, size_t mask)
+{
+  size_t h=c1*0x9e3779b97f4a7c15ull ^ c2;
+  h^=h>>29;
+  return h & mask;
+}
+
+/**
+ * If the cache holds the result of comparing @b t1 and @b t2,
+ * assign it into @b res and return true.
+ *
+ * Only comparisons between shared terms are cached.
+ */
+bool Ordering::tryGetCachedResult(TermList t1, TermList t2, Result& res) const
+{
+  CALL("Ordering::tryGetCachedResult");
+
+  if(!_resultCacheMask || !t1.term()->shared() || !t2.term()->shared()) {
+    return false;
+  }
+  size_t c1=t1.content();
+  size_t c2=t2.content();
+  bool reversed=c1>c2;
+  if(reversed) {
+    std::swap(c1,c2);
+  }
+  const CachedResult& entry=_resultCache[resultCacheIndex(c1,c2,_resultCacheMask)];
+  if(entry.t1!=c1 || entry.t2!=c2) {
+    env.statistics->orderingCacheMisses++;
+    return false;
+  }
+  env.statistics->orderingCacheHits++;
+  res=reversed ? reverse(entry.res) : entry.res;
+  return true;
+}
+
+/**
+ * Store @b res as the result of comparing @b t1 and @b t2, replacing
+ * whatever comparison the entry held before.
+ */
+void Ordering::cacheResult(TermList t1, TermList t2, Result res) const
+{
+  CALL("Ordering::cacheResult");
+
+  if(!_resultCacheMask || !t1.term()->shared() || !t2.term()->shared()) {
+    return;
+  }
+  size_t c1=t1.content();
+  size_t c2=t2.content();
+  if(c1>c2) {
+    std::swap(c1,c2);
+    res=reverse(res);
+  }
+  CachedResult& entry=_resultCache[resultCacheIndex(c1,c2,_resultCacheMask)];
+  entry.t1=c1;
+  entry.t2=c2;
+  entry.res=res;
+}
+
 /**
  * Creates the ordering
  *
@@ -649,6 +737,8 @@ PrecedenceOrdering::PrecedenceOrdering(Problem& prb, const Options& opt)
   CALL("PrecedenceOrdering::PrecedenceOrdering");
   ASS_G(_predicates, 0);
 
+  initResultCache(opt.orderingCacheSize());
+
   DArray<unsigned> aux(32);
   if(_functions) {
     aux.initFromIterator(getRangeIterator(0u, _functions), _functions);
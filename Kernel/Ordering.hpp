@@ -115,6 +115,10 @@ protected:
 
   Result compareEqualities(Literal* eq1, Literal* eq2) const;
 
+  void initResultCache(unsigned capacity);
+  bool tryGetCachedResult(TermList t1, TermList t2, Result& res) const;
+  void cacheResult(TermList t1, TermList t2, Result res) const;
+
 private:
 
   enum ArgumentOrderVals {
@@ -147,6 +151,21 @@ private:
   /** Object used to compare equalities */
   EqCmp* _eqCmp;
 
+  /** Entry of the cache of comparison results, keyed on the contents of the compared terms */
+  struct CachedResult {
+    size_t t1;
+    size_t t2;
+    Result res;
+  };
+  /**
+   * Direct mapped cache of results of comparisons between shared terms.
+   * Shared terms are never destroyed, so a pair of them identifies
+   * a comparison for the whole run. Empty if caching is disabled.
+   */
+  mutable DArray<CachedResult> _resultCache;
+  /** Mask selecting an entry of @b _resultCache from a hash */
+  size_t _resultCacheMask;
+
   /**
    * We store orientation of equalities in this ordering inside
    * the term sharing structure. Setting an ordering to be global
@@ -333,6 +333,22 @@ class Signature
   unsigned addSkolemPredicate(unsigned arity,const char* suffix = 0);
   unsigned addNamePredicate(unsigned arity);
 
+  /**
+   * Reserve @b cnt numbers for the names of fresh symbols and return the first of them
+   *
+   * A forked process can be given a part of the reserved block by
+   * setNextFreshSymbolNumber(), so that the fresh symbols it introduces
+   * do not clash with those of other processes.
+   */
+  int reserveFreshSymbolNumbers(unsigned cnt)
+  {
+    int res = _nextFreshSymbolNumber;
+    _nextFreshSymbolNumber += cnt;
+    return res;
+  }
+  void setNextFreshSymbolNumber(int num) { _nextFreshSymbolNumber = num; }
+  int nextFreshSymbolNumber() const { return _nextFreshSymbolNumber; }
+
   // Interpreted symbol declarations
   unsigned addIntegerConstant(const vstring& number,bool defaultSort);
   unsigned addRationalConstant(const vstring& numerator, const vstring& denominator,bool defaultSort);
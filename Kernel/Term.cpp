@@ -1039,6 +1039,19 @@ unsigned Term::computeDistinctVars() const
   return vars.size();
 }
 
+/**
+ * Return the weight of the term with the symbols weighted by the table
+ * of the term sharing structure, see TermSharing::symbolWeight().
+ * @pre The term is shared
+ */
+unsigned Term::symbolWeight() const
+{
+  CALL("Term::symbolWeight");
+  ASS(shared());
+
+  return env.sharing->symbolWeight(this);
+} // Term::symbolWeight
+
 /**
  * True if each function and predicate symbols in this term or literal are
  * marked as skip for the purpose of symbol elimination.
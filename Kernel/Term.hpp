@@ -410,6 +410,8 @@ public:
     _weight = w;
   } // setWeight
 
+  unsigned symbolWeight() const;
+
   /** Set the number of variables */
   void setVars(unsigned v)
   {
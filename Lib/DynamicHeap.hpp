@@ -110,6 +110,37 @@ public:
     return res;
   }
 
+  /**
+   * Remove @c obj from the heap
+   */
+  void remove(TArg obj)
+  {
+    CALL("DynamicHeap::remove");
+    ASS(contains(obj));
+
+    size_t idx1 = _elMap.get(obj);
+    size_t backIdx1 = size();
+    _elMap.remove(obj);
+
+    T* data1 = getData1();
+    if(idx1!=backIdx1) {
+      data1[idx1] = data1[backIdx1];
+      _elMap.set(data1[idx1], idx1);
+    }
+    _heap.expand(backIdx1-1);
+
+    if(idx1!=backIdx1) {
+      //the element moved from the back can be either smaller
+      //than its new parent or greater than its new children
+      if(idx1>1 && isGreater1(idx1/2, idx1)) {
+	fixDecrease1(idx1);
+      }
+      else {
+	fixIncrease1(idx1);
+      }
+    }
+  }
+
   void notifyIncrease(TArg obj)
   {
     CALL("DynamicHeap::notifyIncrease");
@@ -149,6 +180,16 @@ public:
   bool isEmpty() const { return size()==0; }
 
   ElMap& elMap() { return _elMap; }
+
+  /**
+   * Iterator over the elements of the heap, in no particular order
+   */
+  class Iterator
+  : public DArray<T>::Iterator
+  {
+  public:
+    Iterator(DynamicHeap& heap) : DArray<T>::Iterator(heap._heap) {}
+  };
 private:
   //'1' appended to a function name means that it receives one-based indexes as arguments
 
@@ -197,6 +197,26 @@ private:
   T* _afterLast;
 };
 
+/**
+ * Iterator class for pointers returning references to elements
+ *
+ * The constructor takes two arguments - a pointer to the first element,
+ * and a pointer to the element after the last element to be returned.
+ */
+template<typename T>
+class PointerRefIterator
+{
+public:
+  DECL_ELEMENT_TYPE(T&);
+  inline PointerRefIterator(T* first, T* afterLast) :
+    _curr(first), _afterLast(afterLast) {}
+  inline bool hasNext() { ASS(_curr<=_afterLast); return _curr!=_afterLast; }
+  inline T& next() { ASS(hasNext()); return *(_curr++); }
+private:
+  T* _curr;
+  T* _afterLast;
+};
+
 
 /**
  * Iterator returning a single element
@@ -628,11 +628,11 @@ public:
     inline
     void replace(C val)
     {
-      ASS(_writer < _stack._cursor);
-      ASS(_writer >= _stack._stack);
+      ASS(_writer <= _stack._cursor);
+      ASS(_writer > _stack._stack);
       ASS(_last == 1);
 
-      *_writer = val;
+      *(_writer-1) = val;
     }
   private:
     /** pointer to the stack element returned by next() */
@@ -309,6 +309,9 @@ void TimeCounter::outputSingleStat(TimeCounterUnit tcu, ostream& out)
   case TC_BCE:
     out<<"blocked clause elimination";
     break;
+  case TC_CLAUSIFICATION:
+    out<<"clausification";
+    break;
   case TC_PROPERTY_EVALUATION:
     out<<"property evaluation";
     break;
@@ -402,6 +405,7 @@ void TimeCounter::outputSingleStat(TimeCounterUnit tcu, ostream& out)
     break;
   case TC_NAMING:
     out << "naming";
+    break;
   case TC_LITERAL_SELECTION:
     out << "literal selection";
     break;
@@ -38,6 +38,7 @@ enum TimeCounterUnit
   TC_PROPERTY_EVALUATION,
   TC_PREPROCESSING,
   TC_BCE,
+  TC_CLAUSIFICATION,
   TC_SINE_SELECTION,
   TC_BDD,
   TC_BDD_CLAUSIFICATION,
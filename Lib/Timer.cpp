@@ -109,7 +109,12 @@ timer_sigalrm_handler (int sig)
 
   timer_sigalrm_counter++;
 
-  if(Timer::s_timeLimitEnforcement && env.timeLimitReached()) {
+  if(env.statistics) {
+    env.statistics->samplePhase();
+  }
+
+  // the timer starts ticking before Environment gets to store it in env.timer
+  if(Timer::s_timeLimitEnforcement && env.timer && env.timeLimitReached()) {
     timeLimitReached();
   }
 
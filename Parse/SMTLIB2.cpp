@@ -75,7 +75,8 @@ void SMTLIB2::parse(istream& str)
   CALL("SMTLIB2::parse(istream&)");
 
   LispLexer lex(str);
-  LispParser lpar(lex);
+  // identifiers are interned, so that each distinct one is stored just once
+  LispParser lpar(lex,true);
   LExpr* expr = lpar.parse();
   parse(expr);
 }
@@ -845,11 +846,11 @@ void SMTLIB2::readDefineFun(const vstring& name, LExprList* iArgs, LExpr* oSort,
     argSorts.push(vSort);
   }
 
-  _scopes.push(lookup);
+  pushScope(lookup);
 
   ParseResult res = parseTermOrFormula(body);
 
-  delete _scopes.pop();
+  delete popScope();
 
   TermList rhs;
   if (res.asTerm(rhs) != rangeSort) {
@@ -1314,7 +1315,7 @@ void SMTLIB2::parseLetPrepareLookup(LExpr* exp)
     }
   }
 
-  _scopes.push(lookup);
+  pushScope(lookup);
 }
 
 void SMTLIB2::parseLetEnd(LExpr* exp)
@@ -1331,7 +1332,7 @@ void SMTLIB2::parseLetEnd(LExpr* exp)
   // with a list of bindings
   LispListReader bindRdr(lRdr.readList());
 
-  TermLookup* lookup = _scopes.pop();
+  TermLookup* lookup = popScope();
 
   // there has to be the body result:
   TermList let;
@@ -1400,7 +1401,7 @@ void SMTLIB2::parseQuantBegin(LExpr* exp)
     }
   }
 
-  _scopes.push(lookup);
+  pushScope(lookup);
 
   _todo.push(make_pair(PO_PARSE_APPLICATION,exp)); // will create the actual quantified formula and clear the lookup...
   _todo.push(make_pair(PO_PARSE,lRdr.readNext())); // ... from the only remaining argument, the body
@@ -1436,21 +1437,53 @@ void SMTLIB2::parseAnnotatedTerm(LExpr* exp)
   _todo.push(make_pair(PO_PARSE,toParse));
 }
 
-bool SMTLIB2::parseAsScopeLookup(const vstring& id)
+void SMTLIB2::pushScope(TermLookup* lookup)
 {
-  CALL("SMTLIB2::parseAsScopeLookup");
+  CALL("SMTLIB2::pushScope");
 
-  Scopes::Iterator sIt(_scopes);
-  while (sIt.hasNext()) {
-    TermLookup* lookup = sIt.next();
+  _scopes.push(lookup);
 
-    SortedTerm st;
-    if (lookup->find(id,st)) {
-      _results.push(ParseResult(st.second,st.first));
-      return true;
+  TermLookup::Iterator it(*lookup);
+  while (it.hasNext()) {
+    vstring id;
+    SortedTerm binding;
+    it.next(id,binding);
+
+    SortedTerm previous;
+    bool wasBound = _visibleBindings.find(id,previous);
+    _shadowedBindings.push(ShadowedBinding(id,wasBound,previous));
+    _visibleBindings.set(id,binding);
+  }
+}
+
+SMTLIB2::TermLookup* SMTLIB2::popScope()
+{
+  CALL("SMTLIB2::popScope");
+
+  TermLookup* lookup = _scopes.pop();
+
+  for (unsigned i = lookup->size(); i > 0; i--) {
+    ShadowedBinding sb = _shadowedBindings.pop();
+    if (sb.wasBound) {
+      _visibleBindings.set(sb.id,sb.binding);
+    } else {
+      ALWAYS(_visibleBindings.remove(sb.id));
     }
   }
 
+  return lookup;
+}
+
+bool SMTLIB2::parseAsScopeLookup(const vstring& id)
+{
+  CALL("SMTLIB2::parseAsScopeLookup");
+
+  SortedTerm st;
+  if (_visibleBindings.find(id,st)) {
+    _results.push(ParseResult(st.second,st.first));
+    return true;
+  }
+
   return false;
 }
 
@@ -1767,7 +1800,7 @@ bool SMTLIB2::parseAsBuiltinFormulaSymbol(const vstring& id, LExpr* exp)
         Formula::VarList::push(varIdx, qvars);
         Formula::SortList::push(sort,qsorts);
       }
-      delete _scopes.pop();
+      delete popScope();
 
       Formula* res = new QuantifiedFormula((fs==FS_EXISTS) ? Kernel::EXISTS : Kernel::FORALL, qvars, qsorts, argFla);
 
@@ -2146,22 +2179,17 @@ SMTLIB2::ParseResult SMTLIB2::parseTermOrFormula(LExpr* body)
         // INTENTIONAL FALL-THROUGH FOR ATOMS
       }
       case PO_PARSE_APPLICATION: { // the arguments have already been parsed
-        vstring id;
-        if (exp->isAtom()) { // the fall-through case
-          id = exp->str;
-        } else {
-          ASS(exp->isList());
-          LispListReader lRdr(exp->list);
-
-          LExpr* head = lRdr.readNext();
+        LExpr* head = exp;
+        if (exp->isList()) {
+          head = exp->list->head();
 
           if (head->isList()) {
             parseRankedFunctionApplication(exp);
             continue;
           }
-          ASS(head->isAtom());
-          id = head->str;
         }
+        ASS(head->isAtom());
+        const vstring& id = head->str;
 
         if (parseAsScopeLookup(id)) {
           continue;
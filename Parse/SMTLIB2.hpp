@@ -338,6 +338,32 @@ private:
    */
   Scopes _scopes;
 
+  /**
+   * The innermost binding of every identifier bound in _scopes,
+   * so that an identifier is resolved by a single lookup
+   * instead of by walking through all the scopes, which is quadratic
+   * on long chains of nested lets.
+   */
+  TermLookup _visibleBindings;
+
+  /** A binding hidden in _visibleBindings by a scope pushed later */
+  struct ShadowedBinding {
+    ShadowedBinding() {}
+    ShadowedBinding(const vstring& id, bool wasBound, SortedTerm binding)
+     : id(id), wasBound(wasBound), binding(binding) {}
+
+    vstring id;
+    bool wasBound;
+    SortedTerm binding;
+  };
+  /** Bindings to be restored by popScope, each scope contributing as many as it binds */
+  Stack<ShadowedBinding> _shadowedBindings;
+
+  /** Push @b lookup to _scopes, making its bindings visible */
+  void pushScope(TermLookup* lookup);
+  /** Pop the top of _scopes, restoring the bindings it shadowed, and return it */
+  TermLookup* popScope();
+
   /**
    * Stack of partial results used by parseTermOrFormula below.
    */
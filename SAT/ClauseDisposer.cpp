@@ -160,6 +160,54 @@ void ClauseDisposer::keepMostActive(size_t numberOfKept, ActivityType minActivit
   }
 }
 
+/**
+ * Order learnt clauses so that the least useful one is the smallest:
+ * higher literal block distance first, lower activity among equal ones.
+ */
+struct ClauseLbdComparator
+{
+  static Comparison compare(SATClause* c1, SATClause* c2)
+  {
+    if(c1->lbd()!=c2->lbd()) {
+      return Int::compare(c2->lbd(), c1->lbd());
+    }
+    return Int::compare(c1->activity(), c2->activity());
+  }
+};
+
+void ClauseDisposer::keepBestLbd(size_t numberOfKept)
+{
+  CALL("ClauseDisposer::keepBestLbd");
+
+  static BinaryHeap<SATClause*, ClauseLbdComparator> blh; //best lbd heap
+  blh.reset();
+
+  SATClauseStack::Iterator lrnIt(getLearntStack());
+  while(lrnIt.hasNext()) {
+    SATClause* cl = lrnIt.next();
+    blh.insert(cl);
+    if(blh.size()>numberOfKept) {
+      blh.pop();
+    }
+  }
+  while(!blh.isEmpty()) {
+    blh.pop()->setKept(true);
+  }
+}
+
+void ClauseDisposer::keepGlue(unsigned maxLbd)
+{
+  CALL("ClauseDisposer::keepGlue");
+
+  SATClauseStack::Iterator lrnIt(getLearntStack());
+  while(lrnIt.hasNext()) {
+    SATClause* cl = lrnIt.next();
+    if(cl->lbd()<=maxLbd) {
+      cl->setKept(true);
+    }
+  }
+}
+
 void ClauseDisposer::keepBinary()
 {
   CALL("ClauseDisposer::keepBinary");
@@ -296,5 +344,34 @@ void GrowingClauseDisposer::onRestart()
 
 }
 
+///////////////////////////
+// LBDClauseDisposer
+
+void LBDClauseDisposer::onConflict()
+{
+  CALL("LBDClauseDisposer::onConflict");
+
+  DecayingClauseDisposer::onConflict();
+  _conflictCnt++;
+}
+
+void LBDClauseDisposer::onSafeSpot()
+{
+  CALL("LBDClauseDisposer::onSafeSpot");
+
+  if(_conflictCnt<_reductionInterval) {
+    return;
+  }
+  _conflictCnt = 0;
+  _reductionInterval += TWLSolver::LBD_REDUCTION_INCREMENT;
+
+  markAllRemovableUnkept();
+
+  keepBestLbd(getLearntStack().size()/2);
+  keepGlue(2);
+  keepBinary();
+
+  removeUnkept();
+}
 
 }
@@ -68,7 +68,9 @@ protected:
   void markAllRemovableUnkept();
   void removeUnkept();
   void keepMostActive(size_t numberOfKept, ActivityType minActivity);
+  void keepBestLbd(size_t numberOfKept);
   void keepBinary();
+  void keepGlue(unsigned maxLbd);
 
   TWLSolver& _solver;
 };
@@ -175,6 +177,30 @@ protected:
   size_t _survivorCnt;
 };
 
+/**
+ * Clause disposer that periodically halves the learnt clause database,
+ * keeping the clauses with the lowest literal block distance and all
+ * "glue" clauses, i.e. those whose literals were assigned on at most
+ * two decision levels when they were learnt.
+ */
+class LBDClauseDisposer : public DecayingClauseDisposer
+{
+public:
+  CLASS_NAME(LBDClauseDisposer);
+  USE_ALLOCATOR(LBDClauseDisposer);
+
+  LBDClauseDisposer(TWLSolver& solver, ActivityType decayFactor = 1.001f)
+   : DecayingClauseDisposer(solver, decayFactor), _conflictCnt(0), _reductionInterval(TWLSolver::LBD_FIRST_REDUCTION) {}
+
+  virtual void onSafeSpot();
+  virtual void onConflict();
+protected:
+  /** number of conflicts since the last reduction */
+  size_t _conflictCnt;
+  /** number of conflicts between reductions, grows after each reduction */
+  size_t _reductionInterval;
+};
+
 }
 
 #endif // __ClauseDisposer__
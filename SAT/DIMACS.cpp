@@ -22,11 +22,20 @@
  */
 
 
+#include <climits>
+#include <cstring>
 #include <iostream>
 #include <fstream>
+#include <iterator>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "Lib/BinaryHeap.hpp"
 #include "Lib/DHMap.hpp"
+#include "Lib/Exception.hpp"
 #include "Lib/Int.hpp"
 #include "Lib/List.hpp"
 #include "Lib/MapToLIFO.hpp"
@@ -126,98 +135,220 @@ void DIMACS::outputProblem(SATClauseList* clauses, ostream& out)
   }
 }
 
-template <class T>
-static T readT(istream& str, bool survive_eof = false) {
-  T res;
-  str >> res;
-  if (str.fail() && !(survive_eof && str.eof())) {
-    cout << "Invalid input.\n";
-    exit(0);
+/**
+ * The content of a DIMACS input, memory-mapped when read from a file
+ */
+class DIMACSInput
+{
+public:
+  DIMACSInput(const char* fname) : _mapped(0), _mappedSize(0)
+  {
+    CALL("DIMACSInput::DIMACSInput");
+
+    if(!fname) {
+      readStream(cin);
+      return;
+    }
+    int fd = open(fname, O_RDONLY);
+    if(fd==-1) {
+      USER_ERROR("Cannot open file "+vstring(fname));
+    }
+    struct stat st;
+    if(fstat(fd, &st)==0 && S_ISREG(st.st_mode) && st.st_size>0) {
+      void* mem = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if(mem!=MAP_FAILED) {
+        _mapped = mem;
+        _mappedSize = st.st_size;
+        _begin = static_cast<const char*>(mem);
+        _end = _begin+st.st_size;
+        close(fd);
+        return;
+      }
+    }
+    close(fd);
+    //not a regular file, or it cannot be mapped, so we read it instead
+    BYPASSING_ALLOCATOR;
+    ifstream inp(fname);
+    readStream(inp);
   }
-  return res;
-}
 
-SATClauseList* DIMACS::parse(const char* fname, unsigned& maxVar)
-{
-  CALL("DIMACS::parse");
+  ~DIMACSInput()
+  {
+    if(_mapped) {
+      munmap(_mapped, _mappedSize);
+    }
+  }
 
-  istream* inp0;
+  const char* begin() const { return _begin; }
+  const char* end() const { return _end; }
 
-  if(fname) {
-    // CAREFUL: this might not be enough if the ifstream (re)allocates while being operated
-    BYPASSING_ALLOCATOR;
-    
-    inp0=new ifstream(fname);
-  } else {
-    inp0=&cin;
+private:
+  void readStream(istream& inp)
+  {
+    CALL("DIMACSInput::readStream");
+
+    _buffer.assign(istreambuf_iterator<char>(inp), istreambuf_iterator<char>());
+    _begin = _buffer.data();
+    _end = _begin+_buffer.size();
   }
 
-  istream& inp=*inp0;
-  if(!inp.good()) {
-    cout<<"Cannot open file.\n";
-    exit(0);
+  void* _mapped;
+  size_t _mappedSize;
+  vstring _buffer;
+  const char* _begin;
+  const char* _end;
+};
+
+static inline bool isDIMACSSpace(char c)
+{
+  return c==' ' || c=='\n' || c=='\t' || c=='\r';
+}
+
+static inline const char* skipLine(const char* p, const char* end)
+{
+  while(p!=end && *p!='\n') {
+    p++;
   }
+  return p;
+}
 
-  char ch = readT<char>(inp);
-  while(ch=='c') {
-    inp.ignore(numeric_limits<streamsize>::max(),'\n');
-    ch = readT<char>(inp);
+/**
+ * Read a decimal integer starting at @b p and return the position after it
+ */
+static const char* readInt(const char* p, const char* end, int& res)
+{
+  bool negative = false;
+  if(p!=end && (*p=='-' || *p=='+')) {
+    negative = *p=='-';
+    p++;
+  }
+  if(p==end || *p<'0' || *p>'9') {
+    USER_ERROR("Invalid DIMACS input: number expected");
   }
-  // the line should look like "p cnf #vars #clauses" ...
-  if (ch != 'p') {
-    cout<<"Invalid input: 'p' expected.\n";
+  unsigned val = 0;
+  while(p!=end && *p>='0' && *p<='9') {
+    val = val*10+(*p-'0');
+    if(val>static_cast<unsigned>(INT_MAX)) {
+      USER_ERROR("Invalid DIMACS input: number too large");
+    }
+    p++;
   }
-  // skip one more word -- should be "cnf"
-  readT<char>(inp);
-  inp.ignore(numeric_limits<streamsize>::max(),' ');
-  unsigned num_vars = readT<unsigned>(inp);
-  unsigned num_cls = readT<unsigned>(inp);
-  
-  SATClauseList* res=0;
-  Stack<int> vars(64);
-  
+  res = negative ? -static_cast<int>(val) : static_cast<int>(val);
+  return p;
+}
+
+/**
+ * Parse a DIMACS file (or the standard input if @b fname is 0),
+ * passing each clause to @b consumer as soon as its terminating
+ * zero is read. Files are memory-mapped, so the input is never
+ * copied; only the literals of the current clause are buffered.
+ */
+void DIMACS::parse(const char* fname, ClauseConsumer& consumer, unsigned& maxVar)
+{
+  CALL("DIMACS::parse/3");
+
+  DIMACSInput input(fname);
+  const char* p = input.begin();
+  const char* end = input.end();
+
+  bool headerRead = false;
+  unsigned num_vars = 0;
+  unsigned num_cls = 0;
   unsigned numCls = 0;
-  maxVar = 0;  
-  
-  int lit = readT<int>(inp,true);
-  while (!inp.eof()) {  
-    while (lit != 0) {            
+  maxVar = 0;
+
+  static Stack<int> lits(64);
+  lits.reset();
+
+  while(p!=end) {
+    char c = *p;
+    if(isDIMACSSpace(c)) {
+      p++;
+      continue;
+    }
+    if(c=='c') {
+      p = skipLine(p, end);
+      continue;
+    }
+    if(c=='%') {
+      //the SATLIB benchmarks end with "%\n0\n"
+      break;
+    }
+    if(c=='p') {
+      if(headerRead) {
+        USER_ERROR("Invalid DIMACS input: repeated 'p' line");
+      }
+      p++;
+      while(p!=end && isDIMACSSpace(*p)) { p++; }
+      if(end-p<3 || strncmp(p, "cnf", 3)!=0) {
+        USER_ERROR("Invalid DIMACS input: 'p cnf' expected");
+      }
+      p+=3;
+      int val;
+      while(p!=end && isDIMACSSpace(*p)) { p++; }
+      p = readInt(p, end, val);
+      num_vars = val;
+      while(p!=end && isDIMACSSpace(*p)) { p++; }
+      p = readInt(p, end, val);
+      num_cls = val;
+      headerRead = true;
+      consumer.onHeader(num_vars, num_cls);
+      continue;
+    }
+    if(!headerRead) {
+      USER_ERROR("Invalid DIMACS input: 'p' expected");
+    }
+
+    int lit;
+    p = readInt(p, end, lit);
+    if(lit!=0) {
       unsigned var = abs(lit);
-      if (var > maxVar)
-        maxVar = var;      
-      vars.push(lit);            
-      lit = readT<int>(inp);
-    }
-    
-    lit = readT<int>(inp,true);
-    
+      if(var>maxVar) {
+        maxVar = var;
+      }
+      lits.push(lit);
+      continue;
+    }
+
     numCls++;
-    unsigned clen=(unsigned)vars.size();
+    unsigned clen=(unsigned)lits.size();
     SATClause* cl=new(clen) SATClause(clen, true);
-    for(int i=(int)clen-1; i>=0;i--) {
-      int l = vars.pop();
+    for(unsigned i=0;i<clen;i++) {
+      int l = lits[i];
       (*cl)[i].set(abs(l), l>0);
     }
-    ASS(vars.isEmpty());
-
-    SATClauseList::push(cl,res);
+    lits.reset();
+    consumer.onClause(cl);
+  }
+  if(lits.isNonEmpty()) {
+    USER_ERROR("Invalid DIMACS input: the last clause is not terminated by 0");
   }
 
   if (num_vars != maxVar)
-    cout << "Warning: DIMACS input mis-specifies the number of variables (" 
+    cout << "Warning: DIMACS input mis-specifies the number of variables ("
             << num_vars << " specified and " << maxVar << " read).\n";
   if (num_cls != numCls)
-    cout << "Warning: DIMACS input mis-specifies the number of clauses (" 
+    cout << "Warning: DIMACS input mis-specifies the number of clauses ("
             << num_cls << " specified and " << numCls << " read).\n";
-  
-  if(inp0!=&cin) {
-    BYPASSING_ALLOCATOR;
-    
-    delete inp0;
-  }
-
-  return res;
 }
 
+/**
+ * Collects parsed clauses into a list
+ */
+struct ClauseListConsumer : public DIMACS::ClauseConsumer
+{
+  ClauseListConsumer() : res(0) {}
+  virtual void onClause(SATClause* cl) { SATClauseList::push(cl, res); }
+  SATClauseList* res;
+};
+
+SATClauseList* DIMACS::parse(const char* fname, unsigned& maxVar)
+{
+  CALL("DIMACS::parse");
+
+  ClauseListConsumer consumer;
+  parse(fname, consumer, maxVar);
+  return consumer.res;
+}
 
 }
@@ -35,7 +35,20 @@ namespace SAT
 class DIMACS
 {
 public:
+  /**
+   * Receives the clauses of a DIMACS file as soon as they are read
+   */
+  class ClauseConsumer
+  {
+  public:
+    virtual ~ClauseConsumer() {}
+    /** Called with the numbers from the "p cnf" line before any clause */
+    virtual void onHeader(unsigned varCnt, unsigned clauseCnt) {}
+    virtual void onClause(SATClause* cl) = 0;
+  };
+
   static SATClauseList* parse(const char* fname, unsigned& maxVar);
+  static void parse(const char* fname, ClauseConsumer& consumer, unsigned& maxVar);
 
   static void outputGroundedProblem(MapToLIFO<Clause*, SATClause*>& insts,
 	  SATClause::NamingContext& nctx, ostream& out);
@@ -26,6 +26,9 @@
 #include "Lib/ScopedLet.hpp"
 
 #include "Lib/DArray.hpp"
+#include "Lib/Environment.hpp"
+
+#include "Shell/Statistics.hpp"
 
 namespace SAT
 {
@@ -103,7 +106,11 @@ void MinisatInterfacing::solveModuloAssumptionsAndSetStatus(unsigned conflictCou
   // TODO: consider calling simplify(); or only from time to time?
     
   _solver.setConfBudget(conflictCountLimit); // treating UINT_MAX as \infty
+  uint64_t conflictsBefore = _solver.conflicts;
+  uint64_t propagationsBefore = _solver.propagations;
   lbool res = _solver.solveLimited(_assumptions);
+  env.statistics->satConflicts += _solver.conflicts-conflictsBefore;
+  env.statistics->satPropagations += _solver.propagations-propagationsBefore;
   
   if (res == l_True) {
     _status = SATISFIABLE;
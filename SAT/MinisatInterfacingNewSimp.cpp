@@ -136,7 +136,11 @@ void MinisatInterfacingNewSimp::solveModuloAssumptionsAndSetStatus(unsigned conf
     //cout << "Before: vars " << bef << ", non-unit clauses " << _solver.nClauses() << endl;
 
     _solver.setConfBudget(conflictCountLimit); // treating UINT_MAX as \infty
+    uint64_t conflictsBefore = _solver.conflicts;
+    uint64_t propagationsBefore = _solver.propagations;
     lbool res = _solver.solveLimited(_assumptions,true,true);
+    env.statistics->satConflicts += _solver.conflicts-conflictsBefore;
+    env.statistics->satPropagations += _solver.propagations-propagationsBefore;
 
     //cout << "After: vars " << bef - _solver.eliminated_vars << ", non-unit clauses " << _solver.nClauses() << endl;
   
@@ -0,0 +1,450 @@
+
+/*
+ * File RecordingSolver.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file RecordingSolver.cpp
+ * Implements classes RecordingSolver and SolverReplayer.
+ */
+
+#include "Lib/Exception.hpp"
+#include "Lib/Int.hpp"
+
+#include "SATClause.hpp"
+
+#include "RecordingSolver.hpp"
+
+namespace SAT
+{
+
+static const char TRACE_MAGIC[] = "VSTR";
+static const unsigned TRACE_MAGIC_LENGTH = 4;
+static const char TRACE_VERSION = 1;
+
+///////////////////////
+// RecordingSolver
+//
+
+unsigned RecordingSolver::s_traceCnt = 0;
+
+RecordingSolver::RecordingSolver(SATSolverWithAssumptions* inner, vstring fname)
+ : _inner(inner)
+{
+  CALL("RecordingSolver::RecordingSolver");
+
+  _out = fopen(fname.c_str(), "wb");
+  if(!_out) {
+    USER_ERROR("Cannot open SAT trace file "+fname);
+  }
+  fwrite(TRACE_MAGIC, 1, TRACE_MAGIC_LENGTH, _out);
+  putc(TRACE_VERSION, _out);
+}
+
+RecordingSolver::~RecordingSolver()
+{
+  CALL("RecordingSolver::~RecordingSolver");
+
+  fclose(_out);
+}
+
+/**
+ * If the sat_trace option is set, return @b inner wrapped into a
+ * RecordingSolver writing into a new file named after the option value
+ * and @b client. Otherwise return @b inner.
+ */
+SATSolverWithAssumptions* RecordingSolver::traceIfRequested(SATSolverWithAssumptions* inner, const Options& opt, const char* client)
+{
+  CALL("RecordingSolver::traceIfRequested");
+
+  if(opt.satTrace()=="off") {
+    return inner;
+  }
+  vstring fname = opt.satTrace()+"_"+client+"_"+Int::toString(s_traceCnt++)+".trace";
+  return new RecordingSolver(inner, fname);
+}
+
+void RecordingSolver::writeUnsigned(unsigned val)
+{
+  CALL("RecordingSolver::writeUnsigned");
+
+  while(val>=0x80) {
+    putc((val&0x7F)|0x80, _out);
+    val >>= 7;
+  }
+  putc(val, _out);
+}
+
+void RecordingSolver::writeClause(SATClause* cl)
+{
+  CALL("RecordingSolver::writeClause");
+
+  unsigned clen = cl->length();
+  writeUnsigned(clen);
+  for(unsigned i=0;i<clen;i++) {
+    writeLiteral((*cl)[i]);
+  }
+}
+
+void RecordingSolver::addClause(SATClause* cl)
+{
+  CALL("RecordingSolver::addClause");
+
+  writeOp(TraceOp::ADD_CLAUSE);
+  writeClause(cl);
+  _inner->addClause(cl);
+}
+
+void RecordingSolver::addClauseIgnoredInPartialModel(SATClause* cl)
+{
+  CALL("RecordingSolver::addClauseIgnoredInPartialModel");
+
+  writeOp(TraceOp::ADD_CLAUSE_IGNORED_IN_PARTIAL_MODEL);
+  writeClause(cl);
+  _inner->addClauseIgnoredInPartialModel(cl);
+}
+
+void RecordingSolver::simplify()
+{
+  CALL("RecordingSolver::simplify");
+
+  writeOp(TraceOp::SIMPLIFY);
+  _inner->simplify();
+}
+
+/**
+ * Record and perform the solve call. The trace is flushed after each
+ * solve call, as Vampire may terminate without destroying the solver.
+ */
+SATSolver::Status RecordingSolver::solve(unsigned conflictCountLimit)
+{
+  CALL("RecordingSolver::solve");
+
+  writeOp(TraceOp::SOLVE);
+  writeUnsigned(conflictCountLimit);
+  Status res = _inner->solve(conflictCountLimit);
+  writeUnsigned(res);
+  fflush(_out);
+  return res;
+}
+
+void RecordingSolver::ensureVarCount(unsigned newVarCnt)
+{
+  CALL("RecordingSolver::ensureVarCount");
+
+  writeOp(TraceOp::ENSURE_VAR_COUNT);
+  writeUnsigned(newVarCnt);
+  _inner->ensureVarCount(newVarCnt);
+}
+
+unsigned RecordingSolver::newVar()
+{
+  CALL("RecordingSolver::newVar");
+
+  writeOp(TraceOp::NEW_VAR);
+  return _inner->newVar();
+}
+
+void RecordingSolver::suggestPolarity(unsigned var, unsigned pol)
+{
+  CALL("RecordingSolver::suggestPolarity");
+
+  writeOp(TraceOp::SUGGEST_POLARITY);
+  writeUnsigned(var);
+  writeUnsigned(pol);
+  _inner->suggestPolarity(var,pol);
+}
+
+void RecordingSolver::randomizeForNextAssignment(unsigned maxVar)
+{
+  CALL("RecordingSolver::randomizeForNextAssignment");
+
+  writeOp(TraceOp::RANDOMIZE_FOR_NEXT_ASSIGNMENT);
+  writeUnsigned(maxVar);
+  _inner->randomizeForNextAssignment(maxVar);
+}
+
+void RecordingSolver::addAssumption(SATLiteral lit)
+{
+  CALL("RecordingSolver::addAssumption");
+
+  writeOp(TraceOp::ADD_ASSUMPTION);
+  writeLiteral(lit);
+  _inner->addAssumption(lit);
+}
+
+void RecordingSolver::retractAllAssumptions()
+{
+  CALL("RecordingSolver::retractAllAssumptions");
+
+  writeOp(TraceOp::RETRACT_ALL_ASSUMPTIONS);
+  _inner->retractAllAssumptions();
+}
+
+SATSolver::Status RecordingSolver::solveUnderAssumptions(const SATLiteralStack& assumps, unsigned conflictCountLimit, bool onlyProperSubusets)
+{
+  CALL("RecordingSolver::solveUnderAssumptions");
+
+  writeOp(TraceOp::SOLVE_UNDER_ASSUMPTIONS);
+  writeUnsigned(assumps.size());
+  SATLiteralStack::ConstIterator ait(assumps);
+  while(ait.hasNext()) {
+    writeLiteral(ait.next());
+  }
+  writeUnsigned(conflictCountLimit);
+  writeUnsigned(onlyProperSubusets);
+  Status res = _inner->solveUnderAssumptions(assumps, conflictCountLimit, onlyProperSubusets);
+  writeUnsigned(res);
+  fflush(_out);
+  return res;
+}
+
+const SATLiteralStack& RecordingSolver::explicitlyMinimizedFailedAssumptions(unsigned conflictCountLimit, bool randomize)
+{
+  CALL("RecordingSolver::explicitlyMinimizedFailedAssumptions");
+
+  writeOp(TraceOp::EXPLICITLY_MINIMIZE_FAILED_ASSUMPTIONS);
+  writeUnsigned(conflictCountLimit);
+  writeUnsigned(randomize);
+  return _inner->explicitlyMinimizedFailedAssumptions(conflictCountLimit, randomize);
+}
+
+///////////////////////
+// SolverReplayer
+//
+
+/**
+ * Load the trace from the file @b fname. The whole trace is read
+ * into memory and checked here, so that run() measures just the solver.
+ */
+SolverReplayer::SolverReplayer(const char* fname)
+ : _fname(fname), _pos(0), _usesAssumptions(false), _solveCalls(0), _statusMismatches(0)
+{
+  CALL("SolverReplayer::SolverReplayer");
+
+  FILE* in = fopen(fname, "rb");
+  if(!in) {
+    USER_ERROR("Cannot open SAT trace file "+_fname);
+  }
+  char buf[65536];
+  size_t cnt;
+  while((cnt = fread(buf, 1, sizeof(buf), in))>0) {
+    _data.append(buf, cnt);
+  }
+  fclose(in);
+
+  if(_data.size()<=TRACE_MAGIC_LENGTH || _data.compare(0, TRACE_MAGIC_LENGTH, TRACE_MAGIC)!=0) {
+    USER_ERROR("Not a SAT trace file: "+_fname);
+  }
+  if(_data[TRACE_MAGIC_LENGTH]!=TRACE_VERSION) {
+    USER_ERROR("Unsupported SAT trace version in "+_fname);
+  }
+  scan();
+}
+
+SolverReplayer::~SolverReplayer()
+{
+  CALL("SolverReplayer::~SolverReplayer");
+
+  while(_clauses.isNonEmpty()) {
+    _clauses.pop()->destroy();
+  }
+}
+
+unsigned SolverReplayer::readUnsigned()
+{
+  CALL("SolverReplayer::readUnsigned");
+
+  unsigned res = 0;
+  unsigned shift = 0;
+  for(;;) {
+    if(_pos==_data.size() || shift>28) {
+      USER_ERROR("Truncated or corrupt SAT trace file "+_fname);
+    }
+    unsigned char byte = _data[_pos++];
+    res |= static_cast<unsigned>(byte&0x7F)<<shift;
+    if(!(byte&0x80)) {
+      return res;
+    }
+    shift += 7;
+  }
+}
+
+void SolverReplayer::skipUnsigneds(unsigned cnt)
+{
+  CALL("SolverReplayer::skipUnsigneds");
+
+  while(cnt--) {
+    readUnsigned();
+  }
+}
+
+/**
+ * Walk through the trace without replaying it, so that a corrupt trace
+ * is reported before any solving starts, and find out whether it uses
+ * assumptions.
+ */
+void SolverReplayer::scan()
+{
+  CALL("SolverReplayer::scan");
+
+  _pos = TRACE_MAGIC_LENGTH+1;
+  while(_pos<_data.size()) {
+    TraceOp op = static_cast<TraceOp>(_data[_pos++]);
+    switch(op) {
+    case TraceOp::ADD_CLAUSE:
+    case TraceOp::ADD_CLAUSE_IGNORED_IN_PARTIAL_MODEL:
+      skipUnsigneds(readUnsigned());
+      break;
+    case TraceOp::SIMPLIFY:
+    case TraceOp::NEW_VAR:
+      break;
+    case TraceOp::SOLVE:
+      skipUnsigneds(2);
+      break;
+    case TraceOp::ENSURE_VAR_COUNT:
+    case TraceOp::RANDOMIZE_FOR_NEXT_ASSIGNMENT:
+      skipUnsigneds(1);
+      break;
+    case TraceOp::SUGGEST_POLARITY:
+      skipUnsigneds(2);
+      break;
+    case TraceOp::ADD_ASSUMPTION:
+      skipUnsigneds(1);
+      _usesAssumptions = true;
+      break;
+    case TraceOp::RETRACT_ALL_ASSUMPTIONS:
+      _usesAssumptions = true;
+      break;
+    case TraceOp::SOLVE_UNDER_ASSUMPTIONS:
+      skipUnsigneds(readUnsigned()+3);
+      _usesAssumptions = true;
+      break;
+    case TraceOp::EXPLICITLY_MINIMIZE_FAILED_ASSUMPTIONS:
+      skipUnsigneds(2);
+      _usesAssumptions = true;
+      break;
+    default:
+      USER_ERROR("Corrupt SAT trace file "+_fname);
+    }
+  }
+}
+
+SATClause* SolverReplayer::readClause()
+{
+  CALL("SolverReplayer::readClause");
+
+  unsigned clen = readUnsigned();
+  SATClause* cl = new(clen) SATClause(clen);
+  for(unsigned i=0;i<clen;i++) {
+    (*cl)[i] = readLiteral();
+  }
+  _clauses.push(cl);
+  return cl;
+}
+
+void SolverReplayer::checkStatus(SATSolver::Status res)
+{
+  CALL("SolverReplayer::checkStatus");
+
+  _solveCalls++;
+  if(readUnsigned()!=static_cast<unsigned>(res)) {
+    _statusMismatches++;
+  }
+}
+
+/**
+ * Replay the trace against @b solver and return the status of the last
+ * solve call. If the trace uses assumptions, @b solver must be
+ * a SATSolverWithAssumptions.
+ */
+SATSolver::Status SolverReplayer::run(SATSolver& solver)
+{
+  CALL("SolverReplayer::run");
+
+  SATSolverWithAssumptions* assumptionSolver = dynamic_cast<SATSolverWithAssumptions*>(&solver);
+  ASS(assumptionSolver || !_usesAssumptions);
+  SATSolver::Status res = SATSolver::UNKNOWN;
+  static SATLiteralStack assumps;
+
+  _pos = TRACE_MAGIC_LENGTH+1;
+  _solveCalls = 0;
+  _statusMismatches = 0;
+  while(_pos<_data.size()) {
+    TraceOp op = static_cast<TraceOp>(_data[_pos++]);
+    switch(op) {
+    case TraceOp::ADD_CLAUSE:
+      solver.addClause(readClause());
+      break;
+    case TraceOp::ADD_CLAUSE_IGNORED_IN_PARTIAL_MODEL:
+      solver.addClauseIgnoredInPartialModel(readClause());
+      break;
+    case TraceOp::SIMPLIFY:
+      solver.simplify();
+      break;
+    case TraceOp::SOLVE:
+      res = solver.solve(readUnsigned());
+      checkStatus(res);
+      break;
+    case TraceOp::ENSURE_VAR_COUNT:
+      solver.ensureVarCount(readUnsigned());
+      break;
+    case TraceOp::NEW_VAR:
+      solver.newVar();
+      break;
+    case TraceOp::SUGGEST_POLARITY: {
+      unsigned var = readUnsigned();
+      solver.suggestPolarity(var, readUnsigned());
+      break;
+    }
+    case TraceOp::RANDOMIZE_FOR_NEXT_ASSIGNMENT:
+      solver.randomizeForNextAssignment(readUnsigned());
+      break;
+    case TraceOp::ADD_ASSUMPTION:
+      assumptionSolver->addAssumption(readLiteral());
+      break;
+    case TraceOp::RETRACT_ALL_ASSUMPTIONS:
+      assumptionSolver->retractAllAssumptions();
+      break;
+    case TraceOp::SOLVE_UNDER_ASSUMPTIONS: {
+      assumps.reset();
+      unsigned cnt = readUnsigned();
+      for(unsigned i=0;i<cnt;i++) {
+        assumps.push(readLiteral());
+      }
+      unsigned conflictCountLimit = readUnsigned();
+      bool onlyProperSubsets = readUnsigned();
+      res = assumptionSolver->solveUnderAssumptions(assumps, conflictCountLimit, onlyProperSubsets);
+      checkStatus(res);
+      break;
+    }
+    case TraceOp::EXPLICITLY_MINIMIZE_FAILED_ASSUMPTIONS: {
+      unsigned conflictCountLimit = readUnsigned();
+      bool randomize = readUnsigned();
+      // the recorded solver was minimizing after an unsatisfiable call, which need not be the case here
+      if(res==SATSolver::UNSATISFIABLE) {
+        assumptionSolver->explicitlyMinimizedFailedAssumptions(conflictCountLimit, randomize);
+      }
+      break;
+    }
+    default:
+      ASSERTION_VIOLATION;
+    }
+  }
+  return res;
+}
+
+}
@@ -0,0 +1,159 @@
+
+/*
+ * File RecordingSolver.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file RecordingSolver.hpp
+ * Defines class RecordingSolver, which writes the calls made to a SAT solver
+ * into a binary trace, and class SolverReplayer, which runs such a trace
+ * against any SATSolver.
+ *
+ * The trace starts with the bytes "VSTR" followed by the format version.
+ * Each call is then stored as a one byte TraceOp followed by its arguments,
+ * all of which are unsigned numbers written in the LEB128 variable length
+ * encoding. Literals are stored as their SATLiteral::content() and clauses
+ * as their length followed by their literals. The status returned by
+ * the solve calls is stored after their arguments, so that the replay
+ * can report where the replaying solver behaves differently.
+ */
+
+#ifndef __RecordingSolver__
+#define __RecordingSolver__
+
+#include <cstdio>
+
+#include "Forwards.hpp"
+
+#include "Lib/ScopedPtr.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Shell/Options.hpp"
+
+#include "SATSolver.hpp"
+
+namespace SAT {
+
+using namespace Lib;
+using namespace Shell;
+
+enum class TraceOp : unsigned char {
+  ADD_CLAUSE,
+  ADD_CLAUSE_IGNORED_IN_PARTIAL_MODEL,
+  SIMPLIFY,
+  SOLVE,
+  ENSURE_VAR_COUNT,
+  NEW_VAR,
+  SUGGEST_POLARITY,
+  RANDOMIZE_FOR_NEXT_ASSIGNMENT,
+  ADD_ASSUMPTION,
+  RETRACT_ALL_ASSUMPTIONS,
+  SOLVE_UNDER_ASSUMPTIONS,
+  EXPLICITLY_MINIMIZE_FAILED_ASSUMPTIONS
+};
+
+class RecordingSolver : public SATSolverWithAssumptions {
+public:
+  CLASS_NAME(RecordingSolver);
+  USE_ALLOCATOR(RecordingSolver);
+
+  RecordingSolver(SATSolverWithAssumptions* inner, vstring fname);
+  ~RecordingSolver();
+
+  static SATSolverWithAssumptions* traceIfRequested(SATSolverWithAssumptions* inner, const Options& opt, const char* client);
+
+  virtual void addClause(SATClause* cl) override;
+  virtual void addClauseIgnoredInPartialModel(SATClause* cl) override;
+  virtual void simplify() override;
+  virtual Status solve(unsigned conflictCountLimit) override;
+
+  virtual VarAssignment getAssignment(unsigned var) override { return _inner->getAssignment(var); }
+  virtual bool isZeroImplied(unsigned var) override { return _inner->isZeroImplied(var); }
+  virtual void collectZeroImplied(SATLiteralStack& acc) override { _inner->collectZeroImplied(acc); }
+  virtual SATClause* getZeroImpliedCertificate(unsigned var) override { return _inner->getZeroImpliedCertificate(var); }
+
+  virtual void ensureVarCount(unsigned newVarCnt) override;
+  virtual unsigned newVar() override;
+  virtual void suggestPolarity(unsigned var, unsigned pol) override;
+  virtual void randomizeForNextAssignment(unsigned maxVar) override;
+
+  virtual SATClause* getRefutation() override { return _inner->getRefutation(); }
+  virtual SATClauseList* getRefutationPremiseList() override { return _inner->getRefutationPremiseList(); }
+  virtual void recordSource(unsigned var, Literal* lit) override { _inner->recordSource(var,lit); }
+
+  virtual void addAssumption(SATLiteral lit) override;
+  virtual void retractAllAssumptions() override;
+  virtual bool hasAssumptions() const override { return _inner->hasAssumptions(); }
+
+  virtual Status solveUnderAssumptions(const SATLiteralStack& assumps, unsigned conflictCountLimit, bool onlyProperSubusets) override;
+  virtual const SATLiteralStack& failedAssumptions() override { return _inner->failedAssumptions(); }
+  virtual const SATLiteralStack& explicitlyMinimizedFailedAssumptions(unsigned conflictCountLimit, bool randomize) override;
+
+private:
+  void writeOp(TraceOp op) { putc(static_cast<int>(op), _out); }
+  void writeUnsigned(unsigned val);
+  void writeLiteral(SATLiteral lit) { writeUnsigned(lit.content()); }
+  void writeClause(SATClause* cl);
+
+  ScopedPtr<SATSolverWithAssumptions> _inner;
+  /** The trace file, written through stdio so that its buffers bypass the Allocator */
+  FILE* _out;
+
+  /** Number of traces written so far, used to give each trace its own file */
+  static unsigned s_traceCnt;
+};
+
+class SolverReplayer {
+public:
+  CLASS_NAME(SolverReplayer);
+  USE_ALLOCATOR(SolverReplayer);
+
+  SolverReplayer(const char* fname);
+  ~SolverReplayer();
+
+  SATSolver::Status run(SATSolver& solver);
+
+  /** True if the trace can only be replayed on a SATSolverWithAssumptions */
+  bool usesAssumptions() const { return _usesAssumptions; }
+
+  /** Number of solve calls replayed by the last run() */
+  unsigned solveCalls() const { return _solveCalls; }
+  /** Number of solve calls of the last run() that returned a status different from the recorded one */
+  unsigned statusMismatches() const { return _statusMismatches; }
+
+private:
+  unsigned readUnsigned();
+  SATLiteral readLiteral() { return SATLiteral(readUnsigned()); }
+  SATClause* readClause();
+  void checkStatus(SATSolver::Status res);
+  void skipUnsigneds(unsigned cnt);
+  void scan();
+
+  vstring _fname;
+  vstring _data;
+  size_t _pos;
+  bool _usesAssumptions;
+
+  /** Clauses created by the replay, kept until the replayer is destroyed as the solvers do not own them */
+  SATClauseStack _clauses;
+
+  unsigned _solveCalls;
+  unsigned _statusMismatches;
+};
+
+}
+
+#endif // __RecordingSolver__
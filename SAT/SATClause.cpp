@@ -71,7 +71,7 @@ void* SATClause::operator new(size_t sz,unsigned lits)
 }
 
 SATClause::SATClause(unsigned length,bool kept)
-  : _activity(0), _length(length), _kept(kept?1:0), _nonDestroyable(0), _inference(0)
+  : _activity(0), _length(length), _kept(kept?1:0), _nonDestroyable(0), _lbd(0), _inference(0)
 //      , _genCounter(0xFFFFFFFF)
 {
   env.statistics->satClauses++;
@@ -96,6 +96,14 @@ public:
 
   ActivityType& activity() { return _activity; }
 
+  /**
+   * Literal block distance, i.e. the number of distinct decision
+   * levels among the literals of a learnt clause when it was learnt
+   * (zero for input clauses)
+   */
+  inline unsigned lbd() const { return _lbd; }
+  inline void setLbd(unsigned lbd) { _lbd=lbd; }
+
   void sort();
 
   void destroy();
@@ -140,6 +148,8 @@ protected:
   unsigned _kept : 1;
   unsigned _nonDestroyable : 1;
 //  unsigned _genCounter;
+  /** occupies the padding after the bit fields */
+  unsigned _lbd;
 
   SATInference* _inference;
 
@@ -22,12 +22,15 @@
  */
 
 
+#include <algorithm>
+
 #include "Debug/Assertion.hpp"
 
 #include "Lib/TimeCounter.hpp"
 #include "Lib/Array.hpp"
 #include "Lib/ArrayMap.hpp"
 #include "Lib/BinaryHeap.hpp"
+#include "Lib/DHSet.hpp"
 #include "Lib/Environment.hpp"
 #include "Lib/Int.hpp"
 
@@ -65,7 +68,8 @@ namespace SAT
 using namespace Lib;
 
 TWLSolver::TWLSolver(const Options& opt, bool generateProofs)
-: _generateProofs(generateProofs), _status(SATISFIABLE), _assignment(0), _assignmentLevels(0),
+: _conflictsSinceInprocessing(0), _inprocessingInterval(INPROCESSING_FIRST_INTERVAL),
+_generateProofs(generateProofs), _status(SATISFIABLE), _assignment(0), _assignmentLevels(0),
 _windex(0), _varCnt(0), _level(1), _assumptionsAdded(false), _assumptionCnt(0), _unsatisfiableAssumptions(false)
 {
   switch(opt.satVarSelector()) {
@@ -106,10 +110,14 @@ _windex(0), _varCnt(0), _level(1), _assumptionsAdded(false), _assumptionCnt(0),
   case Options::SatClauseDisposer::MINISAT:
     _clauseDisposer = new MinisatClauseDisposer(*this, opt.satVarActivityDecay());
     break;
+  case Options::SatClauseDisposer::LBD:
+    _clauseDisposer = new LBDClauseDisposer(*this, opt.satVarActivityDecay());
+    break;
   }
 
   _doLearntMinimization = opt.satLearntMinimization();
   _doLearntSubsumptionResolution = opt.satLearntSubsumptionResolution();
+  _doInprocessing = opt.satInprocessing();
 }
 
 TWLSolver::~TWLSolver()
@@ -408,6 +416,12 @@ void TWLSolver::doSolving(unsigned conflictNumberLimit)
 {
   CALL("TWLSolver::doSolving");
 
+  if(readyForInprocessing()) {
+    backtrack(1);
+    doBaseLevelPropagation();
+    inprocess();
+  }
+
   if(conflictNumberLimit!=0) {
     SatLoopResult slRes = runSatLoop(conflictNumberLimit);
     if(slRes==SLR_SATISFIABLE) {
@@ -546,11 +560,12 @@ void TWLSolver::doSubsumptionResolution(SATLiteralStack& lits, SATClauseList*& p
     SATClause* resolvingClause = 0;
     WatchStack::Iterator wit(getWatchStack(rLitOp));
     while(wit.hasNext()) {
-      SATClause* cl = wit.next().cl;
-      if(cl->size()!=2) {
+      Watch watch = wit.next();
+      if(!watch.binary) {
 	continue;
       }
-      SATLiteral other = ((*cl)[0]==rLitOp) ? (*cl)[1] : (*cl)[0];
+      SATClause* cl = watch.cl;
+      SATLiteral other = watch.blocker;
       ASS(other!=rLit);
       ASS(other!=rLitOp);
       ASS((*cl)[0]==rLitOp || (*cl)[1]==rLitOp);
@@ -715,6 +730,7 @@ SATClause* TWLSolver::getLearntClause(SATClause* conflictClause)
   }
 
   SATClause* res = SATClause::fromStack(resLits);
+  res->setLbd(computeLbd(resLits));
 
   if(_generateProofs) {
     ASS(premises);
@@ -750,6 +766,366 @@ SATClause* TWLSolver::getLearntClause(SATClause* conflictClause)
   return res;
 }
 
+/**
+ * Return the number of distinct assignment levels of literals in @c lits
+ */
+unsigned TWLSolver::computeLbd(const SATLiteralStack& lits)
+{
+  CALL("TWLSolver::computeLbd");
+
+  static ArraySet levels;
+  levels.ensure(_level+1);
+  levels.reset();
+
+  unsigned res = 0;
+  SATLiteralStack::ConstIterator it(lits);
+  while(it.hasNext()) {
+    unsigned lev = getAssignmentLevel(it.next());
+    if(!levels.find(lev)) {
+      levels.insert(lev);
+      res++;
+    }
+  }
+  return res;
+}
+
+/**
+ * Return true if enough conflicts passed since the last inprocessing
+ * round and there are no assumptions on the unit stack.
+ *
+ * Inprocessing is only done without assumptions, so everything it
+ * derives follows from the clauses alone and no variable needs to be
+ * protected from it.
+ */
+bool TWLSolver::readyForInprocessing() const
+{
+  CALL("TWLSolver::readyForInprocessing");
+
+  return _doInprocessing && _assumptionCnt==0 &&
+      _conflictsSinceInprocessing>=_inprocessingInterval;
+}
+
+/**
+ * Simplify the learnt clauses
+ *
+ * Learnt clauses subsumed by other learnt clauses are removed, clauses
+ * true at level 1 are removed and literals false at level 1 are dropped.
+ * The remaining clauses are shortened by vivification. Premises of
+ * current assignments are left as they are.
+ */
+void TWLSolver::inprocess()
+{
+  CALL("TWLSolver::inprocess");
+  ASS_EQ(_level, 1);
+  ASS_EQ(_assumptionCnt, 0);
+  ASS(!anythingToPropagate());
+
+  env.statistics->satTWLInprocessings++;
+  _conflictsSinceInprocessing = 0;
+  _inprocessingInterval += INPROCESSING_INTERVAL_INCREMENT;
+
+  detachLearntClauses();
+  removeSubsumedLearnts();
+
+  //vivification makes choices, we don't want it to affect the saved phases
+  static DArray<PackedAsgnVal> savedPhases;
+  savedPhases.initFromArray(_varCnt+1, _lastAssignments);
+
+  unsigned vivificationBudget = VIVIFICATION_BUDGET;
+  static SATLiteralStack lits;
+  static ArraySet seenVars;
+  seenVars.ensure(_varCnt+1);
+
+  SATClauseStack::StableDelIterator lrnIt(_learntClauses);
+  while(lrnIt.hasNext()) {
+    SATClause* cl = lrnIt.next();
+    unsigned clen = cl->length();
+    if(clen<2) {
+      //unit learnt clauses are not in the watch index
+      continue;
+    }
+    if(cl->kept()) {
+      //the clause is a premise, so its implied literal is still watched
+      insertIntoWatchIndex(cl);
+      continue;
+    }
+
+    seenVars.reset();
+    SATClauseList* premises = 0;
+    lits.reset();
+    bool satisfied = false;
+    for(unsigned i=0;i<clen;i++) {
+      SATLiteral lit = (*cl)[i];
+      if(isTrue(lit)) {
+	satisfied = true;
+	break;
+      }
+      if(isUndefined(lit)) {
+	lits.push(lit);
+      }
+      else if(_generateProofs) {
+	collectAssignmentPremises(lit.var(), seenVars, premises);
+      }
+    }
+    if(satisfied) {
+      SATClauseList::destroy(premises);
+      lrnIt.del();
+      cl->destroy();
+      continue;
+    }
+    if(lits.isEmpty()) {
+      SATClauseList::destroy(premises);
+      handleTopLevelConflict(cl);
+    }
+    if(lits.size()>1 && vivificationBudget>0) {
+      vivificationBudget--;
+      vivify(lits, seenVars, premises);
+    }
+    if(lits.size()==clen) {
+      SATClauseList::destroy(premises);
+      cl->setKept(true);
+      insertIntoWatchIndex(cl);
+      continue;
+    }
+
+    env.statistics->satTWLRemovedLearntLiterals += clen-lits.size();
+    SATClause* ncl = SATClause::fromStack(lits);
+    if(_generateProofs) {
+      SATClauseList::push(cl, premises);
+      ncl->setInference(new PropInference(premises));
+    }
+    ncl->activity() = cl->activity();
+    ncl->setLbd(min(cl->lbd(), ncl->length()));
+    lrnIt.replace(ncl);
+    cl->destroy();
+
+    if(ncl->length()==1) {
+      makeForcedAssignment((*ncl)[0], ncl);
+      doBaseLevelPropagation();
+    }
+    else {
+      insertIntoWatchIndex(ncl);
+    }
+  }
+
+  for(unsigned i=1;i<=_varCnt;i++) {
+    _lastAssignments[i] = savedPhases[i];
+  }
+}
+
+/**
+ * Remove all learnt clauses from the watch index. Afterwards, the 'kept'
+ * flag of a learnt clause is set iff it is a premise of some assignment.
+ */
+void TWLSolver::detachLearntClauses()
+{
+  CALL("TWLSolver::detachLearntClauses");
+
+  SATClauseStack::Iterator lrnIt(_learntClauses);
+  while(lrnIt.hasNext()) {
+    lrnIt.next()->setKept(false);
+  }
+
+  //input clauses are always kept
+  unsigned watchCnt = (_varCnt+1)*2;
+  for(unsigned i=2; i<watchCnt; i++) {
+    WatchStack::Iterator wit(_windex[i]);
+    while(wit.hasNext()) {
+      if(!wit.next().cl->kept()) {
+	wit.del();
+      }
+    }
+  }
+
+  for(unsigned i=1; i<=_varCnt; i++) {
+    SATClause* prem = _assignmentPremises[i];
+    if(prem) {
+      prem->setKept(true);
+    }
+  }
+}
+
+static bool shorterClause(SATClause* c1, SATClause* c2)
+{
+  return c1->length()<c2->length();
+}
+
+/**
+ * Remove learnt clauses subsumed by other learnt clauses, except for
+ * those that are premises of some assignment.
+ *
+ * Each potential subsumer is indexed under one of its literals, so
+ * for a clause we only look at the clauses indexed under its literals.
+ */
+void TWLSolver::removeSubsumedLearnts()
+{
+  CALL("TWLSolver::removeSubsumedLearnts");
+
+  static SATClauseStack byLength;
+  byLength.reset();
+  SATClauseStack::Iterator lrnIt(_learntClauses);
+  while(lrnIt.hasNext()) {
+    SATClause* cl = lrnIt.next();
+    if(cl->length()>=2) {
+      byLength.push(cl);
+    }
+  }
+  std::sort(byLength.begin(), byLength.end(), shorterClause);
+
+  unsigned litCnt = (_varCnt+1)*2;
+  static DArray<SATClauseStack> occurrences;
+  occurrences.expand(litCnt);
+  static ArraySet marked;
+  marked.ensure(litCnt);
+  static DHSet<SATClause*> subsumed;
+  subsumed.reset();
+
+  SATClauseStack::BottomFirstIterator blIt(byLength);
+  while(blIt.hasNext()) {
+    SATClause* cl = blIt.next();
+    unsigned clen = cl->length();
+
+    marked.reset();
+    for(unsigned i=0;i<clen;i++) {
+      marked.insert((*cl)[i].content());
+    }
+
+    bool isSubsumed = false;
+    unsigned bestIndex = 0;
+    for(unsigned i=0;i<clen && !isSubsumed;i++) {
+      SATClauseStack& occ = occurrences[(*cl)[i].content()];
+      if(occ.size()<occurrences[(*cl)[bestIndex].content()].size()) {
+	bestIndex = i;
+      }
+      SATClauseStack::Iterator oit(occ);
+      while(oit.hasNext() && !isSubsumed) {
+	SATClause* subsumer = oit.next();
+	ASS_LE(subsumer->length(), clen);
+	isSubsumed = true;
+	for(unsigned j=0;j<subsumer->length();j++) {
+	  if(!marked.find((*subsumer)[j].content())) {
+	    isSubsumed = false;
+	    break;
+	  }
+	}
+      }
+    }
+    if(isSubsumed && !cl->kept()) {
+      subsumed.insert(cl);
+    }
+    else {
+      occurrences[(*cl)[bestIndex].content()].push(cl);
+    }
+  }
+
+  for(unsigned i=0;i<litCnt;i++) {
+    occurrences[i].reset();
+  }
+
+  if(subsumed.isEmpty()) {
+    return;
+  }
+  SATClauseStack::StableDelIterator delIt(_learntClauses);
+  while(delIt.hasNext()) {
+    SATClause* cl = delIt.next();
+    if(subsumed.find(cl)) {
+      delIt.del();
+      cl->destroy();
+      env.statistics->satTWLSubsumedLearnts++;
+    }
+  }
+}
+
+/**
+ * Add to @c premises the clauses the assignment of @c var was derived
+ * from, unless @c var is in @c seenVars. The variables of the added
+ * clauses are put into @c seenVars.
+ */
+void TWLSolver::collectAssignmentPremises(unsigned var, ArraySet& seenVars, SATClauseList*& premises)
+{
+  CALL("TWLSolver::collectAssignmentPremises");
+
+  if(seenVars.find(var)) {
+    return;
+  }
+  seenVars.insert(var);
+
+  static SATClauseStack toDo;
+  toDo.reset();
+  if(_assignmentPremises[var]) {
+    toDo.push(_assignmentPremises[var]);
+  }
+  while(toDo.isNonEmpty()) {
+    SATClause* cl = toDo.pop();
+    SATClauseList::push(cl, premises);
+    SATClause::Iterator cit(*cl);
+    while(cit.hasNext()) {
+      unsigned curVar = cit.next().var();
+      if(seenVars.find(curVar)) {
+	continue;
+      }
+      seenVars.insert(curVar);
+      if(_assignmentPremises[curVar]) {
+	toDo.push(_assignmentPremises[curVar]);
+      }
+    }
+  }
+}
+
+/**
+ * Shorten a clause consisting of literals @c lits, all of which are
+ * undefined at level 1 and the clause itself is not in the watch index.
+ *
+ * The literals are falsified one by one and propagated. A literal that
+ * becomes false can be dropped, one that becomes true or a conflict
+ * makes the remaining literals redundant. When generating proofs,
+ * the clauses used for this are added to @c premises.
+ */
+void TWLSolver::vivify(SATLiteralStack& lits, ArraySet& seenVars, SATClauseList*& premises)
+{
+  CALL("TWLSolver::vivify");
+  ASS_EQ(_level, 1);
+
+  unsigned len = lits.size();
+  unsigned keptCnt = 0;
+  for(unsigned i=0;i<len;i++) {
+    SATLiteral lit = lits[i];
+    if(isFalse(lit)) {
+      if(_generateProofs) {
+	collectAssignmentPremises(lit.var(), seenVars, premises);
+      }
+      continue;
+    }
+    lits[keptCnt++] = lit;
+    if(isTrue(lit)) {
+      if(_generateProofs) {
+	collectAssignmentPremises(lit.var(), seenVars, premises);
+      }
+      break;
+    }
+    if(i==len-1) {
+      break;
+    }
+    makeChoiceAssignment(lit.var(), lit.opposite().polarity());
+    SATClause* conflict = 0;
+    while(anythingToPropagate() && !conflict) {
+      conflict = propagate(pickForPropagation());
+    }
+    if(conflict) {
+      if(_generateProofs) {
+	SATClause::Iterator cit(*conflict);
+	while(cit.hasNext()) {
+	  collectAssignmentPremises(cit.next().var(), seenVars, premises);
+	}
+	SATClauseList::push(conflict, premises);
+      }
+      break;
+    }
+  }
+  backtrack(1);
+  lits.truncate(keptCnt);
+}
+
 TWLSolver::ClauseVisitResult TWLSolver::visitWatchedClause(Watch watch, unsigned var, unsigned& litIndex)
 {
   CALL("TWLSolver::visitWatchedClause");
@@ -773,8 +1149,9 @@ TWLSolver::ClauseVisitResult TWLSolver::visitWatchedClause(Watch watch, unsigned
   ASS_NEQ((*cl)[otherWatchIndex].var(), var);
 
   if(watch.blocker!=otherWatched && isTrue(otherWatched)) {
-//  if(isTrue(otherWatched)) {
-    return VR_NONE; //the other watched literal is true
+    //the other watched literal is true
+    litIndex = otherWatchIndex;
+    return VR_CHANGE_BLOCKER;
   }
   ASS(!isTrue(otherWatched));
 
@@ -784,8 +1161,9 @@ TWLSolver::ClauseVisitResult TWLSolver::visitWatchedClause(Watch watch, unsigned
   for(unsigned i=2;i<clen;i++) { //we start from the first non-watched literal (which is at position 2)
     SATLiteral lit=(*cl)[i];
     if(isTrue(lit)) {
-      //clause is true
-      return VR_NONE;
+      //clause is true, so next time we check the literal that made it so first
+      litIndex = i;
+      return VR_CHANGE_BLOCKER;
     }
     else if(undefIndex==clen && isUndefined(lit)) {
       undefIndex=i;
@@ -823,6 +1201,8 @@ SATClause* TWLSolver::propagate(unsigned var)
   ASS_G(var,0); ASS_LE(var,_varCnt);
   ASS(!isUndefined(var));
 
+  env.statistics->satPropagations++;
+
   //we go through the watch stack of literal opposite to the assigned value
 //  WatchStack::Iterator wit(getTriggeredWatchStack(var, _assignment[var]));
   WatchStack::StableDelIterator wit(getTriggeredWatchStack(var, _assignment[var]));
@@ -830,6 +1210,19 @@ SATClause* TWLSolver::propagate(unsigned var)
     Watch watch=wit.next();
     SATClause* cl = watch.cl;
 
+    if(watch.binary) {
+      //the blocker is the other literal of the clause, so we can decide
+      //without touching the clause itself
+      if(isTrue(watch.blocker)) {
+	continue;
+      }
+      if(isFalse(watch.blocker)) {
+	return cl;
+      }
+      makeForcedAssignment(watch.blocker, cl);
+      continue;
+    }
+
     unsigned litIndex;
     ClauseVisitResult cvr = visitWatchedClause(watch, var, litIndex);
     switch(cvr) {
@@ -851,6 +1244,9 @@ SATClause* TWLSolver::propagate(unsigned var)
       makeForcedAssignment(undefLit, cl);
       break;
     }
+    case VR_CHANGE_BLOCKER:
+      wit.replace(Watch(cl, (*cl)[litIndex]));
+      break;
     case VR_NONE:
       break;
     }
@@ -1431,6 +1827,10 @@ TWLSolver::SatLoopResult TWLSolver::runSatLoop(unsigned conflictCountLimit)
       backtrack(1);
       _variableSelector->onRestart();
       _clauseDisposer->onRestart();
+      if(readyForInprocessing()) {
+	doBaseLevelPropagation();
+	inprocess();
+      }
       conflictsBeforeRestart = _restartStrategy->getNextConflictCount();
       restartASAP = false;
     }
@@ -1473,6 +1873,8 @@ TWLSolver::SatLoopResult TWLSolver::runSatLoop(unsigned conflictCountLimit)
       if(conflictCountLimited && conflictCountLimitRemaining!=0) {
 	conflictCountLimitRemaining--;
       }
+      _conflictsSinceInprocessing++;
+      env.statistics->satConflicts++;
       _variableSelector->onConflict();
       _clauseDisposer->onConflict();
       SATClause* learnt = getLearntClause(conflict);
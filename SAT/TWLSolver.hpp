@@ -45,15 +45,31 @@ namespace SAT {
 using namespace Lib;
 using namespace Shell;
 
+/**
+ * Entry of a watch stack
+ *
+ * The blocker is a literal of the watched clause; when it is true, the
+ * clause can be skipped without being touched. For binary clauses the
+ * blocker is the other literal, so propagation over them never needs to
+ * look at the clause itself. The @b binary flag fits into the padding
+ * after the blocker and so keeps the entry at two words.
+ */
 struct Watch
 {
   Watch() {}
-  Watch(SATClause* cl, SATLiteral blocker) : blocker(blocker), cl(cl)
+  Watch(SATClause* cl, SATLiteral blocker) : blocker(blocker), binary(cl->length()==2), cl(cl)
   {
     CALL("Watch::Watch/2");
-    ASS((*cl)[0]==blocker || (*cl)[1]==blocker);
+#if VDEBUG
+    bool found = false;
+    for(unsigned i=0;i<cl->length();i++) {
+      found |= (*cl)[i]==blocker;
+    }
+    ASS(found);
+#endif
   }
   SATLiteral blocker;
+  bool binary;
   SATClause* cl;
 };
 
@@ -68,6 +84,27 @@ public:
   CLASS_NAME(TWLSolver);
   USE_ALLOCATOR(TWLSolver);
 
+  /*
+   * Tuning parameters of the learnt clause database.
+   *
+   * The reduction schedule of LBDClauseDisposer is the default one of
+   * Glucose (Audemard and Simon, "Predicting Learnt Clauses Quality in
+   * Modern SAT Solvers", IJCAI 2009, with the values of Glucose 3.0).
+   * The inprocessing schedule and the vivification budget were not taken
+   * from anywhere, they are conservative values keeping the inprocessing
+   * rounds rare and cheap compared to the search between them.
+   */
+  /** Number of conflicts before the first reduction of the learnt clauses */
+  static const unsigned LBD_FIRST_REDUCTION = 2000;
+  /** Increase of the number of conflicts between reductions after each reduction */
+  static const unsigned LBD_REDUCTION_INCREMENT = 300;
+  /** Number of conflicts before the first inprocessing round */
+  static const unsigned INPROCESSING_FIRST_INTERVAL = 5000;
+  /** Increase of the number of conflicts between inprocessing rounds after each round */
+  static const unsigned INPROCESSING_INTERVAL_INCREMENT = 1000;
+  /** Maximal number of learnt clauses vivified in one inprocessing round */
+  static const unsigned VIVIFICATION_BUDGET = 2000;
+
   TWLSolver(const Options& opt, bool generateProofs=false);
   ~TWLSolver();
 
@@ -193,6 +230,8 @@ private:
     VR_CONFLICT,
     /** Do nothing */
     VR_NONE,
+    /** Clause is true due to literal at @c litIndex position, which should become the blocker */
+    VR_CHANGE_BLOCKER,
     /** Propagate literal at @c litIndex position */
     VR_PROPAGATE,
     /** Replace the current watch by watching literal at @c litIndex position */
@@ -212,6 +251,14 @@ private:
   void doDeepMinimize(SATLiteralStack& lits, ArraySet& seenVars, SATClauseList*& premises);
   bool isRedundant(SATLiteral lit, ArraySet& seenVars, SATClauseList*& premises);
   SATClause* getLearntClause(SATClause* conflictClause);
+  unsigned computeLbd(const SATLiteralStack& lits);
+
+  bool readyForInprocessing() const;
+  void inprocess();
+  void detachLearntClauses();
+  void removeSubsumedLearnts();
+  void collectAssignmentPremises(unsigned var, ArraySet& seenVars, SATClauseList*& premises);
+  void vivify(SATLiteralStack& lits, ArraySet& seenVars, SATClauseList*& premises);
 
   void insertIntoWatchIndex(SATClause* cl);
 
@@ -244,6 +291,12 @@ private:
 
   bool _doLearntMinimization;
   bool _doLearntSubsumptionResolution;
+  bool _doInprocessing;
+
+  /** Number of conflicts since the last inprocessing round */
+  unsigned _conflictsSinceInprocessing;
+  /** Number of conflicts that have to pass before the next inprocessing round */
+  unsigned _inprocessingInterval;
 
   bool _generateProofs;
   SATClause* _refutation;
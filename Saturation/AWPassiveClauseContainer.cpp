@@ -26,6 +26,7 @@
 
 #include "Debug/RuntimeStatistics.hpp"
 
+#include "Lib/Allocator.hpp"
 #include "Lib/Environment.hpp"
 #include "Lib/Int.hpp"
 #include "Lib/Timer.hpp"
@@ -35,6 +36,7 @@
 #include "Shell/Options.hpp"
 
 #include "SaturationAlgorithm.hpp"
+#include "Splitter.hpp"
 
 #if VDEBUG
 #include <iostream>
@@ -351,6 +353,9 @@ void AWPassiveClauseContainer::onLimitsUpdated(LimitsChangeType change)
 {
   CALL("AWPassiveClauseContainer::onLimitsUpdated");
 
+  if (change & LIMITS_LOOSENED) {
+    reloadFittingSpilled();
+  }
   if (change==LIMITS_LOOSENED) {
     return;
   }
@@ -405,14 +410,91 @@ void AWPassiveClauseContainer::onLimitsUpdated(LimitsChangeType change)
   }
 #endif
 
+  bool spill=spillingAllowed();
+  if (!spill && _spilled.isNonEmpty()) {
+    env.statistics->discardedNonRedundantClauses+=_spilled.size();
+    _spilled.reset();
+  }
+
   while (toRemove.isNonEmpty()) {
     Clause* removed=toRemove.pop();
-    RSTAT_CTR_INC("clauses discarded from passive on weight limit update");
-    env.statistics->discardedNonRedundantClauses++;
+    if (spill) {
+      env.statistics->spilledPassiveClauses++;
+      _spilled.push(removed);
+    } else {
+      RSTAT_CTR_INC("clauses discarded from passive on weight limit update");
+      env.statistics->discardedNonRedundantClauses++;
+    }
     remove(removed);
   }
 }
 
+/**
+ * Return true if clauses removed on limit updates should be set aside
+ * rather than discarded, i.e. if the memory use is below the percentage
+ * of the memory limit given by Options::lrsSpillLimit()
+ */
+bool AWPassiveClauseContainer::spillingAllowed()
+{
+  CALL("AWPassiveClauseContainer::spillingAllowed");
+
+  unsigned percentage=_opt.lrsSpillLimit();
+  if (!percentage) {
+    return false;
+  }
+  return Allocator::getUsedMemory() < Allocator::getMemoryLimit()/100*percentage;
+}
+
+/**
+ * Pass the set aside clauses that fulfill the current limits
+ * to the saturation algorithm as new clauses
+ */
+void AWPassiveClauseContainer::reloadFittingSpilled()
+{
+  CALL("AWPassiveClauseContainer::reloadFittingSpilled");
+
+  SaturationAlgorithm* salg=getSaturationAlgorithm();
+  Limits* limits=salg->getLimits();
+  Splitter* splitter=salg->getSplitter();
+
+  RCClauseStack::DelIterator sit(_spilled);
+  while (sit.hasNext()) {
+    Clause* cl=sit.next();
+    if (!limits->fulfillsLimits(cl)) {
+      continue;
+    }
+    //the splitter may have added the clause again already, or the clause
+    //may depend on splits that were backtracked in the meantime
+    if (cl->store()==Clause::NONE && (!splitter || splitter->allSplitLevelsActive(cl->splits()))) {
+      env.statistics->reloadedPassiveClauses++;
+      salg->addNewClause(cl);
+    }
+    sit.del();
+  }
+}
+
+/**
+ * Lift the limits and add all set aside clauses again.
+ * Return false if no clause was added.
+ *
+ * This is called when the container runs out of clauses.
+ */
+bool AWPassiveClauseContainer::reloadSpilled()
+{
+  CALL("AWPassiveClauseContainer::reloadSpilled");
+
+  if (_spilled.isEmpty()) {
+    return false;
+  }
+  //if the limits were lifted already, no LIMITS_LOOSENED event is fired,
+  //so we do not rely on onLimitsUpdated() to reload the clauses
+  unsigned reloadedBefore=env.statistics->reloadedPassiveClauses;
+  getSaturationAlgorithm()->getLimits()->setLimits(-1,-1);
+  reloadFittingSpilled();
+  ASS(_spilled.isEmpty());
+  return env.statistics->reloadedPassiveClauses!=reloadedBefore;
+}
+
 AWClauseContainer::AWClauseContainer(const Options& opt)
 : _ageQueue(opt), _weightQueue(opt), _ageRatio(1), _weightRatio(1), _balance(0), _size(0)
 {
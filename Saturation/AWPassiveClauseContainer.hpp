@@ -28,6 +28,7 @@
 #include "Lib/Comparison.hpp"
 #include "Kernel/Clause.hpp"
 #include "Kernel/ClauseQueue.hpp"
+#include "Kernel/RCClauseStack.hpp"
 #include "ClauseContainer.hpp"
 
 #include "Lib/Allocator.hpp"
@@ -89,6 +90,7 @@ public:
   ClauseIterator iterator();
 
   void updateLimits(long long estReachableCnt);
+  bool reloadSpilled();
 
   virtual unsigned size() const { return _size; }
 
@@ -98,6 +100,8 @@ protected:
   void onLimitsUpdated(LimitsChangeType change);
 
 private:
+  bool spillingAllowed();
+  void reloadFittingSpilled();
 
   /** The age queue, empty if _ageRatio=0 */
   AgeQueue _ageQueue;
@@ -113,6 +117,12 @@ private:
 
   unsigned _size;
 
+  /**
+   * Clauses removed on limit updates that are to be added again
+   * when the limits are relaxed, see Options::lrsSpillLimit()
+   */
+  RCClauseStack _spilled;
+
   const Options& _opt;
 }; // class AWPassiveClauseContainer
 
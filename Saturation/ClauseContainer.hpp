@@ -138,6 +138,11 @@ public:
   virtual unsigned size() const = 0;
 
   virtual void updateLimits(long long estReachableCnt) {}
+  /**
+   * Add again the clauses that were set aside on limit updates,
+   * return true if there were any
+   */
+  virtual bool reloadSpilled() { return false; }
 };
 
 class ActiveClauseContainer
@@ -49,7 +49,8 @@ void Limits::setLimits(int newMaxAge, int newMaxWeight)
 
   LimitsChangeType res=NO_LIMITS_CHANGE;
   if(_maxAge!=newMaxAge) {
-    if(_maxAge==-1||_maxAge>newMaxAge) {
+    //-1 means no limit, so changing to it loosens the limit
+    if(_maxAge==-1||(newMaxAge!=-1 && _maxAge>newMaxAge)) {
 	res=static_cast<LimitsChangeType>(res|LIMITS_TIGHTENED);
     } else {
 	res=static_cast<LimitsChangeType>(res|LIMITS_LOOSENED);
@@ -57,7 +58,7 @@ void Limits::setLimits(int newMaxAge, int newMaxWeight)
     _maxAge=newMaxAge;
   }
   if(_maxWeight!=newMaxWeight) {
-    if(_maxWeight==-1||_maxWeight>newMaxWeight) {
+    if(_maxWeight==-1||(newMaxWeight!=-1 && _maxWeight>newMaxWeight)) {
 	res=static_cast<LimitsChangeType>(res|LIMITS_TIGHTENED);
     } else {
 	res=static_cast<LimitsChangeType>(res|LIMITS_LOOSENED);
@@ -0,0 +1,523 @@
+
+/*
+ * File MultiQueuePassiveClauseContainer.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file MultiQueuePassiveClauseContainer.cpp
+ * Implements class MultiQueuePassiveClauseContainer.
+ */
+
+#include <math.h>
+
+#include "Debug/RuntimeStatistics.hpp"
+
+#include "Lib/DynamicHeap.hpp"
+#include "Lib/Environment.hpp"
+#include "Lib/Exception.hpp"
+#include "Lib/Int.hpp"
+#include "Lib/Metaiterators.hpp"
+#include "Lib/SharedSet.hpp"
+#include "Lib/StringUtils.hpp"
+#include "Kernel/Clause.hpp"
+#include "Shell/Options.hpp"
+#include "Shell/Statistics.hpp"
+
+#include "AWPassiveClauseContainer.hpp"
+#include "SaturationAlgorithm.hpp"
+
+#include "MultiQueuePassiveClauseContainer.hpp"
+
+namespace Saturation
+{
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * The record of a passive clause, shared by all the queues
+ *
+ * The queues are heaps of pointers to the records, and the record
+ * keeps the position of the clause in each of them, so that the clause
+ * can be removed from any queue in logarithmic time.
+ */
+struct MultiQueuePassiveClauseContainer::Entry
+{
+  CLASS_NAME(MultiQueuePassiveClauseContainer::Entry);
+  USE_ALLOCATOR(MultiQueuePassiveClauseContainer::Entry);
+
+  Entry(Clause* cl, bool withSymbolWeight)
+  : clause(cl), symbolWeight(withSymbolWeight ? cl->symbolWeight() : 0)
+  {
+    for (unsigned i=0;i<QUEUE_KIND_CNT;i++) {
+      positions[i]=0;
+    }
+  }
+
+  Clause* clause;
+  /** Clause::symbolWeight() of the clause if there is a symbol queue, computed once */
+  unsigned symbolWeight;
+  /** one-based position in the heap of each queue, zero if not in the queue */
+  unsigned positions[QUEUE_KIND_CNT];
+};
+
+/**
+ * Element map of the heap of a queue, keeping the positions
+ * in the records themselves
+ */
+class MultiQueuePassiveClauseContainer::PositionMap
+{
+public:
+  PositionMap() : _queueIndex(0) {}
+
+  void setQueueIndex(unsigned idx) { ASS(idx<QUEUE_KIND_CNT); _queueIndex=idx; }
+
+  void insert(Entry* e, size_t pos) { e->positions[_queueIndex]=pos; }
+  void set(Entry* e, size_t pos) { e->positions[_queueIndex]=pos; }
+  size_t get(Entry* e) { return e->positions[_queueIndex]; }
+  void remove(Entry* e) { e->positions[_queueIndex]=0; }
+  bool find(Entry* e) { return e->positions[_queueIndex]!=0; }
+
+private:
+  unsigned _queueIndex;
+};
+
+/**
+ * Ordering of the clauses of a queue, the clause selected first is the least
+ */
+class MultiQueuePassiveClauseContainer::QueueComparator
+{
+public:
+  QueueComparator(QueueKind kind, const Options& opt) : _kind(kind), _opt(opt) {}
+
+  Comparison compare(Entry* e1, Entry* e2);
+
+private:
+  Comparison comparePrimary(Entry* e1,Entry* e2);
+
+  QueueKind _kind;
+  const Options& _opt;
+};
+
+/**
+ * A queue of the container, ordering clauses by the criterion of its kind
+ */
+class MultiQueuePassiveClauseContainer::Queue
+{
+public:
+  CLASS_NAME(MultiQueuePassiveClauseContainer::Queue);
+  USE_ALLOCATOR(MultiQueuePassiveClauseContainer::Queue);
+
+  Queue(QueueKind kind, unsigned ratio, unsigned index, const Options& opt)
+  : kind(kind), ratio(ratio), selected(0), heap(QueueComparator(kind, opt))
+  {
+    heap.elMap().setQueueIndex(index);
+  }
+
+  QueueKind kind;
+  /** how many clauses are selected from this queue relative to the other queues */
+  unsigned ratio;
+  /** number of clauses selected from this queue so far */
+  unsigned long long selected;
+
+  typedef DynamicHeap<Entry*, QueueComparator, PositionMap> Heap;
+  Heap heap;
+};
+
+/**
+ * Compare the clauses by the criterion specific to the kind of the queue
+ */
+Comparison MultiQueuePassiveClauseContainer::QueueComparator::comparePrimary(Entry* e1,Entry* e2)
+{
+  CALL("MultiQueuePassiveClauseContainer::QueueComparator::comparePrimary");
+
+  Clause* c1=e1->clause;
+  Clause* c2=e2->clause;
+
+  switch(_kind) {
+  case AGE_QUEUE:
+    return Int::compare(c1->age(), c2->age());
+  case WEIGHT_QUEUE:
+    return EQUAL;
+  case GOAL_QUEUE:
+    //goal clauses go first
+    return Int::compare(c2->isGoal(), c1->isGoal());
+  case THEORY_QUEUE:
+    return Int::compare(c1->isTheoryDescendant(), c2->isTheoryDescendant());
+  case SPLIT_QUEUE:
+    return Int::compare(c1->splits() ? c1->splits()->size() : 0u,
+                        c2->splits() ? c2->splits()->size() : 0u);
+  case SYMBOL_QUEUE:
+    return Int::compare(e1->symbolWeight, e2->symbolWeight);
+  }
+  ASSERTION_VIOLATION;
+}
+
+/**
+ * Comparison of clauses. The comparison uses five orders in the
+ * following order:
+ * <ol><li>by the criterion of the queue;</li>
+ *     <li>by weight;</li>
+ *     <li>by age;</li>
+ *     <li>by input type;</li>
+ *     <li>by number.</li>
+ * </ol>
+ * For the age and weight queues this is the order of AgeQueue and WeightQueue.
+ */
+Comparison MultiQueuePassiveClauseContainer::QueueComparator::compare(Entry* e1, Entry* e2)
+{
+  CALL("MultiQueuePassiveClauseContainer::QueueComparator::compare");
+
+  Clause* c1=e1->clause;
+  Clause* c2=e2->clause;
+
+  Comparison cmp=comparePrimary(e1, e2);
+  if (cmp!=EQUAL) {
+    return cmp;
+  }
+
+  cmp=AWPassiveClauseContainer::compareWeight(c1, c2, _opt);
+  if (cmp!=EQUAL) {
+    return cmp;
+  }
+
+  cmp=Int::compare(c1->age(), c2->age());
+  if (cmp!=EQUAL) {
+    return cmp;
+  }
+  cmp=Int::compare(c2->inputType(), c1->inputType());
+  if (cmp!=EQUAL) {
+    return cmp;
+  }
+  return Int::compare(c1->number(), c2->number());
+}
+
+MultiQueuePassiveClauseContainer::MultiQueuePassiveClauseContainer(const Options& opt)
+: _hasSymbolQueue(false), _size(0), _opt(opt)
+{
+  CALL("MultiQueuePassiveClauseContainer::MultiQueuePassiveClauseContainer");
+
+  parseQueues(opt.clauseQueues());
+  ASS(_queues.isNonEmpty());
+}
+
+MultiQueuePassiveClauseContainer::~MultiQueuePassiveClauseContainer()
+{
+  Queue::Heap::Iterator eit(_queues[0]->heap);
+  while (eit.hasNext()) {
+    Entry* e=eit.next();
+    ASS(e->clause->store()==Clause::PASSIVE);
+    e->clause->setStore(Clause::NONE);
+    delete e;
+  }
+
+  Stack<Queue*>::Iterator qit(_queues);
+  while (qit.hasNext()) {
+    delete qit.next();
+  }
+}
+
+/**
+ * Create the queues described by @b spec, a comma separated list of
+ * queue:ratio pairs, see Options::clauseQueues()
+ */
+void MultiQueuePassiveClauseContainer::parseQueues(const vstring& spec)
+{
+  CALL("MultiQueuePassiveClauseContainer::parseQueues");
+
+  Stack<vstring> items;
+  StringUtils::splitStr(spec.c_str(), ',', items);
+
+  Stack<vstring>::BottomFirstIterator iit(items);
+  while (iit.hasNext()) {
+    vstring item=iit.next();
+    size_t colon=item.find(':');
+    if (colon==vstring::npos) {
+      USER_ERROR("Clause queue \""+item+"\" is not of the form queue:ratio");
+    }
+    vstring name=item.substr(0, colon);
+    unsigned ratio;
+    if (!Int::stringToUnsignedInt(item.substr(colon+1), ratio) || ratio==0) {
+      USER_ERROR("The ratio of clause queue \""+item+"\" must be a positive integer");
+    }
+
+    QueueKind kind;
+    if (name=="age") {
+      kind=AGE_QUEUE;
+    } else if (name=="weight") {
+      kind=WEIGHT_QUEUE;
+    } else if (name=="goal") {
+      kind=GOAL_QUEUE;
+    } else if (name=="theory") {
+      kind=THEORY_QUEUE;
+    } else if (name=="splits") {
+      kind=SPLIT_QUEUE;
+    } else if (name=="symbols") {
+      kind=SYMBOL_QUEUE;
+    } else {
+      USER_ERROR("Unknown clause queue \""+name+"\"");
+    }
+
+    Stack<Queue*>::Iterator qit(_queues);
+    while (qit.hasNext()) {
+      if (qit.next()->kind==kind) {
+        USER_ERROR("Clause queue \""+name+"\" is given more than once");
+      }
+    }
+    _queues.push(new Queue(kind, ratio, _queues.size(), _opt));
+    if (kind==SYMBOL_QUEUE) {
+      _hasSymbolQueue=true;
+    }
+  }
+  if (_queues.isEmpty()) {
+    USER_ERROR("No clause queues given");
+  }
+}
+
+struct MultiQueuePassiveClauseContainer::EntryClauseFn
+{
+  DECL_RETURN_TYPE(Clause*);
+  Clause* operator()(Entry* e) { return e->clause; }
+};
+
+ClauseIterator MultiQueuePassiveClauseContainer::iterator()
+{
+  return pvi( getMappingIterator(Queue::Heap::Iterator(_queues[0]->heap), EntryClauseFn()) );
+}
+
+/**
+ * Add @b cl to all the queues.
+ */
+void MultiQueuePassiveClauseContainer::add(Clause* cl)
+{
+  CALL("MultiQueuePassiveClauseContainer::add");
+
+  Entry* e=new Entry(cl, _hasSymbolQueue);
+  ALWAYS(_entries.insert(cl, e));
+  Stack<Queue*>::Iterator qit(_queues);
+  while (qit.hasNext()) {
+    qit.next()->heap.insert(e);
+  }
+  _size++;
+  addedEvent.fire(cl);
+}
+
+/**
+ * Remove Clause from the Passive store. Should be called only
+ * when the Clause is no longer needed by the inference process
+ * (i.e. was backward subsumed/simplified), as it can result in
+ * deletion of the clause.
+ */
+void MultiQueuePassiveClauseContainer::remove(Clause* cl)
+{
+  CALL("MultiQueuePassiveClauseContainer::remove");
+  ASS(cl->store()==Clause::PASSIVE);
+
+  Entry* e;
+  ALWAYS(_entries.pop(cl, e));
+  Stack<Queue*>::Iterator qit(_queues);
+  while (qit.hasNext()) {
+    qit.next()->heap.remove(e);
+  }
+  delete e;
+  _size--;
+
+  removedEvent.fire(cl);
+
+  ASS(cl->store()!=Clause::PASSIVE);
+}
+
+/**
+ * Return the queue the next clause should be selected from, i.e. the one
+ * with the fewest selections relative to its ratio. Ties go to the queue
+ * with the greater ratio and then to the one given first, so that
+ * weight:w,age:a selects the same clauses as age_weight_ratio a:w.
+ */
+MultiQueuePassiveClauseContainer::Queue* MultiQueuePassiveClauseContainer::nextQueue()
+{
+  CALL("MultiQueuePassiveClauseContainer::nextQueue");
+
+  Queue* best=_queues[0];
+  for (unsigned i=1;i<_queues.size();i++) {
+    Queue* q=_queues[i];
+    unsigned long long qDebt=q->selected*best->ratio;
+    unsigned long long bestDebt=best->selected*q->ratio;
+    if (qDebt<bestDebt || (qDebt==bestDebt && q->ratio>best->ratio)) {
+      best=q;
+    }
+  }
+  return best;
+}
+
+/**
+ * Return the next selected clause and remove it from the queues.
+ */
+Clause* MultiQueuePassiveClauseContainer::popSelected()
+{
+  CALL("MultiQueuePassiveClauseContainer::popSelected");
+  ASS( ! isEmpty());
+
+  _size--;
+
+  Queue* selQueue=nextQueue();
+  selQueue->selected++;
+  switch(selQueue->kind) {
+  case AGE_QUEUE:
+    env.statistics->ageQueueSelections++;
+    break;
+  case WEIGHT_QUEUE:
+    env.statistics->weightQueueSelections++;
+    break;
+  case GOAL_QUEUE:
+    env.statistics->goalQueueSelections++;
+    break;
+  case THEORY_QUEUE:
+    env.statistics->theoryQueueSelections++;
+    break;
+  case SPLIT_QUEUE:
+    env.statistics->splitQueueSelections++;
+    break;
+  case SYMBOL_QUEUE:
+    env.statistics->symbolQueueSelections++;
+    break;
+  }
+
+  Entry* e=selQueue->heap.pop();
+  Clause* cl=e->clause;
+  Stack<Queue*>::Iterator qit(_queues);
+  while (qit.hasNext()) {
+    Queue* q=qit.next();
+    if (q!=selQueue) {
+      q->heap.remove(e);
+    }
+  }
+  ALWAYS(_entries.remove(cl));
+  delete e;
+  selectedEvent.fire(cl);
+  return cl;
+}
+
+/**
+ * Set the LRS limits so that the @b estReachableCnt clauses that would be
+ * selected next still fulfil them
+ *
+ * The selection is simulated by taking the clauses out of the queues in
+ * the order popSelected() would, and putting them back afterwards. The
+ * age limit is the greatest age of a clause taken from the age queue and
+ * the weight limit the greatest weight of a clause taken from any other
+ * queue. Without an age queue, the age limit is zero and the limits
+ * depend on the weight only, and vice versa.
+ */
+void MultiQueuePassiveClauseContainer::updateLimits(long long estReachableCnt)
+{
+  CALL("MultiQueuePassiveClauseContainer::updateLimits");
+  ASS_GE(estReachableCnt,0);
+
+  int maxAge, maxWeight;
+
+  if (estReachableCnt>=static_cast<long long>(_size)) {
+    maxAge=-1;
+    maxWeight=-1;
+    goto fin;
+  }
+
+  {
+    //the selection counters are advanced by the simulation and restored afterwards
+    static Stack<unsigned long long> selected;
+    selected.reset();
+    Stack<Queue*>::BottomFirstIterator qit(_queues);
+    while (qit.hasNext()) {
+      selected.push(qit.next()->selected);
+    }
+
+    static Stack<Entry*> reached;
+    reached.reset();
+    maxAge=0;
+    maxWeight=0;
+    while (static_cast<long long>(reached.size())<estReachableCnt) {
+      Queue* q=nextQueue();
+      q->selected++;
+
+      Entry* e=q->heap.pop();
+      Stack<Queue*>::Iterator rit(_queues);
+      while (rit.hasNext()) {
+        Queue* q2=rit.next();
+        if (q2!=q) {
+          q2->heap.remove(e);
+        }
+      }
+      reached.push(e);
+
+      Clause* cl=e->clause;
+      if (q->kind==AGE_QUEUE) {
+        maxAge=max(maxAge, static_cast<int>(cl->age()));
+      } else {
+        maxWeight=max(maxWeight, static_cast<int>(ceil(cl->getEffectiveWeight(_opt))));
+      }
+    }
+
+    while (reached.isNonEmpty()) {
+      Entry* e=reached.pop();
+      Stack<Queue*>::Iterator rit(_queues);
+      while (rit.hasNext()) {
+        rit.next()->heap.insert(e);
+      }
+    }
+    for (unsigned i=0;i<_queues.size();i++) {
+      _queues[i]->selected=selected[i];
+    }
+  }
+
+fin:
+  getSaturationAlgorithm()->getLimits()->setLimits(maxAge,maxWeight);
+}
+
+/**
+ * Discard the passive clauses that do not fulfil tightened limits
+ *
+ * Unlike AWPassiveClauseContainer, the container does not set the
+ * clauses aside, so Options::lrsSpillLimit() has no effect on it.
+ */
+void MultiQueuePassiveClauseContainer::onLimitsUpdated(LimitsChangeType change)
+{
+  CALL("MultiQueuePassiveClauseContainer::onLimitsUpdated");
+
+  if (change==LIMITS_LOOSENED) {
+    return;
+  }
+
+  Limits* limits=getSaturationAlgorithm()->getLimits();
+  if (!limits->ageLimited() || !limits->weightLimited()) {
+    return;
+  }
+
+  static Stack<Clause*> toRemove(256);
+  toRemove.reset();
+  Queue::Heap::Iterator eit(_queues[0]->heap);
+  while (eit.hasNext()) {
+    Clause* cl=eit.next()->clause;
+    if (!limits->fulfillsLimits(cl)) {
+      toRemove.push(cl);
+    }
+  }
+
+  while (toRemove.isNonEmpty()) {
+    RSTAT_CTR_INC("clauses discarded from passive on weight limit update");
+    env.statistics->discardedNonRedundantClauses++;
+    remove(toRemove.pop());
+  }
+}
+
+}
@@ -0,0 +1,121 @@
+
+/*
+ * File MultiQueuePassiveClauseContainer.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file MultiQueuePassiveClauseContainer.hpp
+ * Defines the class MultiQueuePassiveClauseContainer
+ */
+
+#ifndef __MultiQueuePassiveClauseContainer__
+#define __MultiQueuePassiveClauseContainer__
+
+#include "Lib/DHMap.hpp"
+#include "Lib/Stack.hpp"
+#include "Kernel/Clause.hpp"
+#include "ClauseContainer.hpp"
+
+#include "Lib/Allocator.hpp"
+
+namespace Saturation {
+
+using namespace Kernel;
+
+/**
+ * Passive clause container with any number of queues, each ordering
+ * the passive clauses by a different criterion. Clauses are selected
+ * from the queues in the ratio given by Options::clauseQueues().
+ *
+ * All queues contain the same set of clauses, so the container is
+ * empty iff any of its queues is. Each clause is stored only once in
+ * a record that keeps its position in every queue, see Entry.
+ *
+ * With the LRS saturation algorithm, the limits are set so that the
+ * clauses the age queue would select before the time runs out fit the
+ * age limit and the clauses any other queue would select fit the weight
+ * limit.
+ */
+class MultiQueuePassiveClauseContainer
+: public PassiveClauseContainer
+{
+public:
+  CLASS_NAME(MultiQueuePassiveClauseContainer);
+  USE_ALLOCATOR(MultiQueuePassiveClauseContainer);
+
+  /** The criteria by which a queue can order clauses */
+  enum QueueKind {
+    /** older clauses first */
+    AGE_QUEUE,
+    /** lighter clauses first */
+    WEIGHT_QUEUE,
+    /** clauses derived from the goal first */
+    GOAL_QUEUE,
+    /** clauses that do not descend from theory axioms first */
+    THEORY_QUEUE,
+    /** clauses depending on fewer AVATAR splits first */
+    SPLIT_QUEUE,
+    /** lighter clauses first, with symbols weighted by Options::symbolWeighting() */
+    SYMBOL_QUEUE
+  };
+  /** Number of queue kinds, which bounds the number of queues */
+  static const unsigned QUEUE_KIND_CNT=SYMBOL_QUEUE+1;
+
+  MultiQueuePassiveClauseContainer(const Options& opt);
+  virtual ~MultiQueuePassiveClauseContainer();
+
+  void add(Clause* cl);
+  void remove(Clause* cl);
+
+  Clause* popSelected();
+  /** True if there are no passive clauses */
+  bool isEmpty() const { return _size==0; }
+
+  ClauseIterator iterator();
+
+  virtual unsigned size() const { return _size; }
+
+  void updateLimits(long long estReachableCnt);
+
+protected:
+  void onLimitsUpdated(LimitsChangeType change);
+
+private:
+  struct Entry;
+  struct EntryClauseFn;
+  class PositionMap;
+  class QueueComparator;
+  class Queue;
+
+  void addQueue(QueueKind kind, unsigned ratio);
+  void parseQueues(const vstring& spec);
+  Queue* nextQueue();
+
+  /** The queues, in the order they were given in the option */
+  Stack<Queue*> _queues;
+  /** The record of each passive clause */
+  DHMap<Clause*,Entry*> _entries;
+  /** True if one of the queues is a SYMBOL_QUEUE */
+  bool _hasSymbolQueue;
+
+  unsigned _size;
+
+  const Options& _opt;
+}; // class MultiQueuePassiveClauseContainer
+
+};
+
+#endif /* __MultiQueuePassiveClauseContainer__ */
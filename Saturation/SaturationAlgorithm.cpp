@@ -75,6 +75,7 @@
 #include "Shell/AnswerExtractor.hpp"
 #include "Shell/Options.hpp"
 #include "Shell/Statistics.hpp"
+#include "Shell/SymbolWeighting.hpp"
 #include "Shell/UIHelper.hpp"
 
 #include "Splitter.hpp"
@@ -85,6 +86,7 @@
 #include "SymElOutput.hpp"
 #include "SaturationAlgorithm.hpp"
 #include "AWPassiveClauseContainer.hpp"
+#include "MultiQueuePassiveClauseContainer.hpp"
 #include "Discount.hpp"
 #include "LRS.hpp"
 #include "Otter.hpp"
@@ -121,12 +123,14 @@ SaturationAlgorithm::SaturationAlgorithm(Problem& prb, const Options& opt)
     _theoryInstSimp(0),
 #endif
     _generatedClauseCount(0),
-    _activationLimit(0)
+    _activationLimit(0),
+    _bwSimplificationBatchSize(0)
 {
   CALL("SaturationAlgorithm::SaturationAlgorithm");
   ASS_EQ(s_instance, 0);  //there can be only one saturation algorithm at a time
 
   _activationLimit = opt.activationLimit();
+  _bwSimplificationBatchSize = opt.backwardSimplificationBatch();
 
   _ordering = OrderingSP(Ordering::create(prb, opt));
   if (!Ordering::trySetGlobalOrdering(_ordering)) {
@@ -138,7 +142,15 @@ SaturationAlgorithm::SaturationAlgorithm(Problem& prb, const Options& opt)
   _completeOptionSettings = opt.complete(prb);
 
   _unprocessed = new UnprocessedClauseContainer();
-  _passive = new AWPassiveClauseContainer(opt);
+  if (opt.symbolWeighting()!=Options::SymbolWeighting::OFF) {
+    SymbolWeighting(opt).apply(prb);
+  }
+  if (opt.clauseQueues().empty()) {
+    _passive = new AWPassiveClauseContainer(opt);
+  }
+  else {
+    _passive = new MultiQueuePassiveClauseContainer(opt);
+  }
   _active = new ActiveClauseContainer(opt);
 
   _active->attach(this);
@@ -895,6 +907,14 @@ void SaturationAlgorithm::backwardSimplify(Clause* cl)
 {
   CALL("SaturationAlgorithm::backwardSimplify");
 
+  if (_bwSimplificationBatchSize) {
+    _bwSimplificationBatch.push(cl);
+    if (_bwSimplificationBatch.size()>=_bwSimplificationBatchSize) {
+      flushBackwardSimplificationBatch();
+    }
+    return;
+  }
+
 
   BwSimplList::Iterator bsit(_bwSimplifiers);
   while (bsit.hasNext()) {
@@ -927,6 +947,89 @@ void SaturationAlgorithm::backwardSimplify(Clause* cl)
   }
 }
 
+/**
+ * Remove from @b premises the clauses that are no longer
+ * in the active or passive container
+ *
+ * The batch stack keeps the clauses alive, so the pointers
+ * of the removed clauses are still valid here.
+ */
+void SaturationAlgorithm::filterBackwardSimplificationPremises(ClauseStack& premises)
+{
+  CALL("SaturationAlgorithm::filterBackwardSimplificationPremises");
+
+  unsigned remaining=0;
+  for (unsigned i=0; i<premises.size(); i++) {
+    Clause* cl=premises[i];
+    if (cl->store()==Clause::ACTIVE || cl->store()==Clause::PASSIVE || cl->store()==Clause::SELECTED) {
+      premises[remaining++]=cl;
+    }
+  }
+  premises.truncate(remaining);
+}
+
+/**
+ * Perform backward simplification with all clauses collected
+ * in the @b _bwSimplificationBatch stack
+ *
+ * Clauses of the batch that were deleted in the meantime are skipped.
+ * The function must not be called during clause activation.
+ */
+void SaturationAlgorithm::flushBackwardSimplificationBatch()
+{
+  CALL("SaturationAlgorithm::flushBackwardSimplificationBatch");
+  ASS(!_clauseActivationInProgress);
+
+  static ClauseStack premises;
+  premises.reset();
+  RCClauseStack::Iterator bit(_bwSimplificationBatch);
+  while (bit.hasNext()) {
+    premises.push(bit.next());
+  }
+  filterBackwardSimplificationPremises(premises);
+  if (premises.isNonEmpty()) {
+    env.statistics->backwardSimplificationBatches++;
+  }
+
+  BwSimplList::Iterator bsit(_bwSimplifiers);
+  while (bsit.hasNext() && premises.isNonEmpty()) {
+    BackwardSimplificationEngine* bse=bsit.next();
+
+    BwSimplificationRecordIterator simplifications;
+    bse->performBatch(premises, simplifications);
+    while (simplifications.hasNext()) {
+      BwSimplificationRecord srec=simplifications.next();
+      Clause* redundant=srec.toRemove;
+      Clause* replacement=srec.replacement;
+      ASS(srec.premise);
+      ASS_NEQ(redundant, srec.premise);
+
+      if (redundant->store()!=Clause::ACTIVE && redundant->store()!=Clause::PASSIVE) {
+	//already removed by a simplification performed by a previous engine
+	if (replacement) {
+	  replacement->destroyIfUnnecessary();
+	}
+	continue;
+      }
+
+      if (replacement) {
+	addNewClause(replacement);
+      }
+      onClauseReduction(redundant, replacement, srec.premise, false);
+
+      redundant->incRefCnt();
+      removeActiveOrPassiveClause(redundant);
+      redundant->decRefCnt();
+    }
+
+    //some premises may have been removed by this engine and must
+    //not be passed as simplifiers to the following ones
+    filterBackwardSimplificationPremises(premises);
+  }
+
+  _bwSimplificationBatch.reset();
+}
+
 /**
  * Remove either passive or active (or reactivated, which is both)
  * clause @b cl
@@ -975,6 +1078,40 @@ void SaturationAlgorithm::addToPassive(Clause* cl)
   _passive->add(cl);
 }
 
+/**
+ * Passes the conclusions of generating inferences to
+ * SaturationAlgorithm::addGeneratedClause
+ */
+class SaturationAlgorithm::GeneratedClauseAdder
+: public GeneratedClauseConsumer
+{
+public:
+  GeneratedClauseAdder(SaturationAlgorithm& salg) : _salg(salg) {}
+  void consume(Clause* cl) override { _salg.addGeneratedClause(cl); }
+private:
+  SaturationAlgorithm& _salg;
+};
+
+/**
+ * Add a clause generated during the activation of a clause to the
+ * new clauses and report its premises
+ */
+void SaturationAlgorithm::addGeneratedClause(Clause* genCl)
+{
+  CALL("SaturationAlgorithm::addGeneratedClause");
+
+  addNewClause(genCl);
+
+  Inference::Iterator iit=genCl->inference()->iterator();
+  while (genCl->inference()->hasNext(iit)) {
+    Unit* premUnit=genCl->inference()->next(iit);
+    ASS(premUnit->isClause());
+    Clause* premCl=static_cast<Clause*>(premUnit);
+
+    onParenthood(genCl, premCl);
+  }
+}
+
 /**
  * Activate clause @b cl
  *
@@ -1024,25 +1161,26 @@ bool SaturationAlgorithm::activate(Clause* cl)
   ASS_EQ(cl->store(), Clause::SELECTED);
   cl->setStore(Clause::ACTIVE);
   env.statistics->activeClauses++;
+  if (env.statistics->firstActivationTime==-1) {
+    env.statistics->firstActivationTime=env.timer->elapsedMilliseconds();
+  }
   _active->add(cl);
 
 
+  if (_opt.pushGeneratedClauses()) {
+    while (instances.hasNext()) {
+      addGeneratedClause(instances.next());
+    }
+    GeneratedClauseAdder adder(*this);
+    _generator->generateClausesInto(cl, adder);
+  }
+  else {
     ClauseIterator toAdd= pvi(getConcatenatedIterator(instances,_generator->generateClauses(cl)));
 
     while (toAdd.hasNext()) {
-      Clause* genCl=toAdd.next();
-
-      addNewClause(genCl);
-
-      Inference::Iterator iit=genCl->inference()->iterator();
-      while (genCl->inference()->hasNext(iit)) {
-        Unit* premUnit=genCl->inference()->next(iit);
-        ASS(premUnit->isClause());
-        Clause* premCl=static_cast<Clause*>(premUnit);
-
-        onParenthood(genCl, premCl);
-      }
+      addGeneratedClause(toAdd.next());
     }
+  }
 
   _clauseActivationInProgress=false;
 
@@ -1159,6 +1297,18 @@ void SaturationAlgorithm::doOneAlgorithmStep()
 
   doUnprocessedLoop();
 
+  if (_bwSimplificationBatch.isNonEmpty() && _passive->isEmpty()) {
+    //the batch may still delete or rewrite clauses, so we cannot
+    //conclude saturation before it is processed
+    flushBackwardSimplificationBatch();
+    doUnprocessedLoop();
+  }
+
+  if (_passive->isEmpty() && _passive->reloadSpilled()) {
+    //the clauses set aside on limit updates go through forward simplification again
+    doUnprocessedLoop();
+  }
+
   if (_passive->isEmpty()) {
     MainLoopResult::TerminationReason termReason =
 	isComplete() ? Statistics::SATISFIABLE : Statistics::REFUTATION_NOT_FOUND;
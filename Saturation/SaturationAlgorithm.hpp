@@ -145,6 +145,8 @@ protected:
   void addUnprocessedClause(Clause* cl);
   bool forwardSimplify(Clause* c);
   void backwardSimplify(Clause* c);
+  void flushBackwardSimplificationBatch();
+  void filterBackwardSimplificationPremises(ClauseStack& premises);
   void addToPassive(Clause* c);
   bool activate(Clause* c);
   virtual void onSOSClauseAdded(Clause* c) {}
@@ -170,6 +172,7 @@ private:
   LiteralSelector& getSosLiteralSelector();
 
   void handleEmptyClause(Clause* cl);
+  void addGeneratedClause(Clause* genCl);
   Clause* doImmediateSimplification(Clause* cl);
   MainLoopResult saturateImpl();
   Limits _limits;
@@ -177,6 +180,7 @@ private:
 
   class TotalSimplificationPerformer;
   class PartialSimplificationPerformer;
+  class GeneratedClauseAdder;
 
   static SaturationAlgorithm* s_instance;
 protected:
@@ -236,6 +240,11 @@ protected:
   unsigned _generatedClauseCount;
 
   unsigned _activationLimit;
+
+  /** Clauses waiting for batched backward simplification */
+  RCClauseStack _bwSimplificationBatch;
+  /** Size of the backward simplification batch, zero if batching is off */
+  unsigned _bwSimplificationBatchSize;
 };
 
 
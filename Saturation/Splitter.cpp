@@ -53,6 +53,7 @@
 #include "SAT/FallbackSolverWrapper.hpp"
 #include "SAT/MinisatInterfacing.hpp"
 #include "SAT/Z3Interfacing.hpp"
+#include "SAT/RecordingSolver.hpp"
 
 #include "DP/ShortConflictMetaDP.hpp"
 
@@ -78,10 +79,10 @@ void SplittingBranchSelector::init()
 
   switch(_parent.getOptions().satSolver()){
     case Options::SatSolver::VAMPIRE:  
-      _solver = new TWLSolver(_parent.getOptions(), true);
+      _solver = RecordingSolver::traceIfRequested(new TWLSolver(_parent.getOptions(), true), _parent.getOptions(), "splitter");
       break;
     case Options::SatSolver::MINISAT:
-      _solver = new MinisatInterfacing(_parent.getOptions(),true);
+      _solver = RecordingSolver::traceIfRequested(new MinisatInterfacing(_parent.getOptions(),true), _parent.getOptions(), "splitter");
       break;      
 #if VZ3
     case Options::SatSolver::Z3:
@@ -211,6 +211,8 @@ public:
   }
   Clause* getComponentClause(SplitLevel name) const;
 
+  bool allSplitLevelsActive(SplitSet* s);
+
   SplitLevel splitLevelCnt() const { return _db.size(); }
   unsigned maxSatVar() const { return _sat2fo.maxSATVar(); }
 
@@ -245,8 +247,6 @@ private:
   SplitSet* getNewClauseSplitSet(Clause* cl);
   void assignClauseSplitSet(Clause* cl, SplitSet* splits);
 
-  bool allSplitLevelsActive(SplitSet* s);
-
   //settings
   bool _showSplitting;
 
@@ -28,6 +28,7 @@
 #include "Indexing/TermSharing.hpp"
 
 #include "Lib/Environment.hpp"
+#include "Lib/Int.hpp"
 
 #include "Kernel/Clause.hpp"
 #include "Kernel/FormulaUnit.hpp"
@@ -154,6 +155,8 @@ FormulaUnit* FOOLElimination::apply(FormulaUnit* unit) {
 
   _unit = rectifiedUnit;
   _varSorts.reset();
+  _termTranslations.reset();
+  _literalTranslations.reset();
 
   SortHelper::collectVariableSorts(formula, _varSorts);
 
@@ -430,17 +433,36 @@ Formula* FOOLElimination::processAsFormula(TermList terms) {
 void FOOLElimination::process(Term* term, Context context, TermList& termResult, Formula*& formulaResult) {
   CALL("FOOLElimination::process(Term* term, Context context, ...)");
 
-  // collect free variables of the term and their sorts
-  Formula::VarList* freeVars = term->freeVariables();
-  Stack<unsigned> freeVarsSorts = collectSorts(freeVars);
+  if (term->shared()) {
+    /**
+     * Special terms cannot be shared, and neither can terms that contain them.
+     * So a shared term has nothing to eliminate and we return it as it is,
+     * without walking the (possibly exponential) tree of its DAG.
+     */
+    if (context == FORMULA_CONTEXT) {
+      formulaResult = toEquality(TermList(term));
+    } else {
+      termResult = TermList(term);
+    }
+    return;
+  }
+
+  if (findTranslation(term, context, termResult, formulaResult)) {
+    return;
+  }
+
+#if VDEBUG
+  Formula::VarList* inputFreeVars = term->freeVariables();
+#endif
 
   /**
-   * Note that we collected free variables before processing subterms. That
-   * assumes that process() preserves free variables. This assumption relies
-   * on the fact that $ite and formula terms are rewritten into an fresh symbol
-   * applied to free variables, and the processing of $let-terms itself doesn't
-   * remove occurrences of variables. An assertion at the end of this method
-   * checks that free variables of the input and the result coincide.
+   * Free variables of $ite-terms and formula terms are collected before
+   * processing their subterms. That assumes that process() preserves free
+   * variables. This assumption relies on the fact that $ite and formula terms
+   * are rewritten into an fresh symbol applied to free variables, and the
+   * processing of $let-terms itself doesn't remove occurrences of variables.
+   * An assertion at the end of this method checks that free variables of the
+   * input and the result coincide.
    */
 
   if (!term->isSpecial()) {
@@ -494,8 +516,15 @@ void FOOLElimination::process(Term* term, Context context, TermList& termResult,
          *     * ![X1, ..., Xn]: ( f => g(X1, ..., Xn) = s)
          *     * ![X1, ..., Xn]: (~f => g(X1, ..., Xn) = t)
          *  3) Replace the term with g(X1, ..., Xn)
+         *
+         * If the same $ite-term was already processed, g and its definitions
+         * are reused.
          */
 
+        // collect free variables of the term and their sorts
+        Formula::VarList* freeVars = term->freeVariables();
+        Stack<unsigned> freeVarsSorts = collectSorts(freeVars);
+
         Formula* condition = process(sd->getCondition());
 
         TermList thenBranch;
@@ -513,14 +542,34 @@ void FOOLElimination::process(Term* term, Context context, TermList& termResult,
           ASS_EQ(resultSort, SortHelper::getResultSort(elseBranch, _varSorts));
         }
 
-        // create a fresh symbol g
-        unsigned freshSymbol = introduceFreshSymbol(context, ITE_PREFIX, freeVarsSorts, resultSort);
+        vstring key = definitionKey("$ite", context, freeVars) + Int::toString(resultSort) + "," +
+                      condition->toString() + "," +
+                      (context == FORMULA_CONTEXT ? thenBranchFormula->toString() : thenBranch.toString()) + "," +
+                      (context == FORMULA_CONTEXT ? elseBranchFormula->toString() : elseBranch.toString());
+
+        // create a fresh symbol g, unless the term already has one
+        unsigned freshSymbol;
+        bool alreadyDefined = _definedSymbols.find(key, freshSymbol);
+        if (!alreadyDefined) {
+          freshSymbol = introduceFreshSymbol(context, ITE_PREFIX, freeVarsSorts, resultSort);
+          _definedSymbols.insert(key, freshSymbol);
+        }
 
         // build g(X1, ..., Xn)
         TermList freshFunctionApplication;
         Formula* freshPredicateApplication;
         buildApplication(freshSymbol, freeVars, context, freshFunctionApplication, freshPredicateApplication);
 
+        if (context == FORMULA_CONTEXT) {
+          formulaResult = freshPredicateApplication;
+        } else {
+          termResult = freshFunctionApplication;
+        }
+
+        if (alreadyDefined) {
+          break;
+        }
+
         // build g(X1, ..., Xn) == s
         Formula* thenEq = buildEq(context, freshPredicateApplication, thenBranchFormula,
                                            freshFunctionApplication, thenBranch, resultSort);
@@ -551,12 +600,6 @@ void FOOLElimination::process(Term* term, Context context, TermList& termResult,
         Inference* iteInference = new Inference1(Inference::FOOL_ITE_ELIMINATION, _unit);
         addDefinition(new FormulaUnit(thenImplication, iteInference, DEFINITION_INPUT_TYPE));
         addDefinition(new FormulaUnit(elseImplication, iteInference, DEFINITION_INPUT_TYPE));
-
-        if (context == FORMULA_CONTEXT) {
-          formulaResult = freshPredicateApplication;
-        } else {
-          termResult = freshFunctionApplication;
-        }
         break;
       }
 
@@ -576,6 +619,9 @@ void FOOLElimination::process(Term* term, Context context, TermList& termResult,
          *  3) Build a term t' by replacing all of its subterms of the form
          *     f(t1, ..., tk) by g(X1, ..., Xn, t1, ..., tk)
          *  4) Replace the term with t'
+         *
+         * If the same binding was already processed, g and its definition are
+         * reused.
          */
 
         TermList binding = sd->getBinding(); // deliberately unprocessed here
@@ -625,41 +671,41 @@ void FOOLElimination::process(Term* term, Context context, TermList& termResult,
         if(bindingContext == TERM_CONTEXT && !env.signature->getFunction(symbol)->introduced()) renameSymbol = true;
         if(bindingContext == FORMULA_CONTEXT && !env.signature->getPredicate(symbol)->introduced()) renameSymbol = true;
 
-        // create a fresh function or predicate symbol g
-        unsigned freshSymbol = renameSymbol ? introduceFreshSymbol(bindingContext, LET_PREFIX, sorts, bindingSort) : symbol;
-
         // process the body of the function
         TermList processedBody;
         Formula* processedBodyFormula;
         process(binding, bindingContext, processedBody, processedBodyFormula);
 
-        // build g(X1, ..., Xn, Y1, ..., Yk)
-        TermList freshFunctionApplication;
-        Formula* freshPredicateApplication;
-        buildApplication(freshSymbol, vars, bindingContext, freshFunctionApplication, freshPredicateApplication);
-
-        // build g(X1, ..., Xn, Y1, ..., Yk) == s
-        Formula* freshSymbolDefinition = buildEq(bindingContext, freshPredicateApplication, processedBodyFormula,
-                                                                 freshFunctionApplication, processedBody, bindingSort);
-
-        // build ![X1, ..., Xn, Y1, ..., Yk]: g(X1, ..., Xn, Y1, ..., Yk) == s
-        if (Formula::VarList::length(vars) > 0) {
-        /*
-          Formula::SortList* sortList = Formula::SortList::empty();
-          Formula::VarList* vp = vars;
-          while(vp){
-            cout << vp->head() << endl;
-            sortList = new Formula::SortList(sorts[vp->head()],sortList);
-            vp = vp->tail();
-            cout << vp << endl;
-          }
-        */ 
-          freshSymbolDefinition = new QuantifiedFormula(FORALL, vars, 0, freshSymbolDefinition);
+        vstring key = definitionKey("$let", bindingContext, vars) + Int::toString(symbol) + "," +
+                      (bindingContext == FORMULA_CONTEXT ? processedBodyFormula->toString() : processedBody.toString());
+
+        // create a fresh function or predicate symbol g, unless the binding already has one
+        unsigned freshSymbol;
+        bool alreadyDefined = _definedSymbols.find(key, freshSymbol);
+        if (!alreadyDefined) {
+          freshSymbol = renameSymbol ? introduceFreshSymbol(bindingContext, LET_PREFIX, sorts, bindingSort) : symbol;
+          _definedSymbols.insert(key, freshSymbol);
         }
 
-        // add the introduced definition
-        Inference* letInference = new Inference1(Inference::FOOL_LET_ELIMINATION, _unit);
-        addDefinition(new FormulaUnit(freshSymbolDefinition, letInference, DEFINITION_INPUT_TYPE));
+        if (!alreadyDefined) {
+          // build g(X1, ..., Xn, Y1, ..., Yk)
+          TermList freshFunctionApplication;
+          Formula* freshPredicateApplication;
+          buildApplication(freshSymbol, vars, bindingContext, freshFunctionApplication, freshPredicateApplication);
+
+          // build g(X1, ..., Xn, Y1, ..., Yk) == s
+          Formula* freshSymbolDefinition = buildEq(bindingContext, freshPredicateApplication, processedBodyFormula,
+                                                                   freshFunctionApplication, processedBody, bindingSort);
+
+          // build ![X1, ..., Xn, Y1, ..., Yk]: g(X1, ..., Xn, Y1, ..., Yk) == s
+          if (Formula::VarList::length(vars) > 0) {
+            freshSymbolDefinition = new QuantifiedFormula(FORALL, vars, 0, freshSymbolDefinition);
+          }
+
+          // add the introduced definition
+          Inference* letInference = new Inference1(Inference::FOOL_LET_ELIMINATION, _unit);
+          addDefinition(new FormulaUnit(freshSymbolDefinition, letInference, DEFINITION_INPUT_TYPE));
+        }
 
         TermList contents = *term->nthArgument(0); // deliberately unprocessed here
 
@@ -711,12 +757,27 @@ void FOOLElimination::process(Term* term, Context context, TermList& termResult,
          *  2) Add the definition: ![X1, ..., Xn]: (f <=> g(X1, ..., Xn) = true),
          *     where true is FOOL constant
          *  3) Replace the term with g(X1, ..., Xn)
+         *
+         * If the same formula was already processed, g and its definition are
+         * reused.
          */
 
+        // collect free variables of the term and their sorts
+        Formula::VarList* freeVars = term->freeVariables();
+        Stack<unsigned> freeVarsSorts = collectSorts(freeVars);
+
         Formula *formula = process(sd->getFormula());
 
-        // create a fresh symbol g and build g(X1, ..., Xn)
-        unsigned freshSymbol = introduceFreshSymbol(context, BOOL_PREFIX, freeVarsSorts, Sorts::SRT_BOOL);
+        vstring key = definitionKey("$formula", context, freeVars) + formula->toString();
+
+        // create a fresh symbol g, unless the formula already has one, and build g(X1, ..., Xn)
+        unsigned freshSymbol;
+        if (_definedSymbols.find(key, freshSymbol)) {
+          termResult = buildFunctionApplication(freshSymbol, freeVars);
+          break;
+        }
+        freshSymbol = introduceFreshSymbol(context, BOOL_PREFIX, freeVarsSorts, Sorts::SRT_BOOL);
+        _definedSymbols.insert(key, freshSymbol);
         TermList freshSymbolApplication = buildFunctionApplication(freshSymbol, freeVars);
 
         // build f <=> g(X1, ..., Xn) = true
@@ -747,6 +808,8 @@ void FOOLElimination::process(Term* term, Context context, TermList& termResult,
     }
   }
 
+  rememberTranslation(term, context, termResult, formulaResult);
+
 #if VDEBUG
   // free variables of the input and the result should coincide
   Formula::VarList* resultFreeVars;
@@ -756,7 +819,7 @@ void FOOLElimination::process(Term* term, Context context, TermList& termResult,
     resultFreeVars = formulaResult->freeVariables();
   }
 
-  Formula::VarList::Iterator ufv(freeVars);
+  Formula::VarList::Iterator ufv(inputFreeVars);
   while (ufv.hasNext()) {
     unsigned var = (unsigned)ufv.next();
     ASS_REP(Formula::VarList::member(var, resultFreeVars), var);
@@ -764,7 +827,7 @@ void FOOLElimination::process(Term* term, Context context, TermList& termResult,
   Formula::VarList::Iterator pfv(resultFreeVars);
   while (pfv.hasNext()) {
     unsigned var = (unsigned)pfv.next();
-    ASS_REP(Formula::VarList::member(var, freeVars), var);
+    ASS_REP(Formula::VarList::member(var, inputFreeVars), var);
   }
 
   // special subterms should be eliminated
@@ -774,6 +837,61 @@ void FOOLElimination::process(Term* term, Context context, TermList& termResult,
 #endif
 }
 
+/**
+ * If the given unshared term was already processed in the given context within
+ * the current unit, write the result of that processing to termResult or
+ * formulaResult and return true.
+ */
+bool FOOLElimination::findTranslation(Term* term, Context context, TermList& termResult, Formula*& formulaResult) {
+  CALL("FOOLElimination::findTranslation");
+
+  if (context == TERM_CONTEXT) {
+    return _termTranslations.find(term, termResult);
+  }
+
+  // formulas are not shared, so every occurrence gets its own atomic formula
+  Literal* literal;
+  if (!_literalTranslations.find(term, literal)) {
+    return false;
+  }
+  formulaResult = new AtomicFormula(literal);
+  return true;
+}
+
+/**
+ * Remember the result of processing of a given unshared term, so that its
+ * other occurrences in the current unit can reuse it.
+ */
+void FOOLElimination::rememberTranslation(Term* term, Context context, TermList termResult, Formula* formulaResult) {
+  CALL("FOOLElimination::rememberTranslation");
+
+  if (context == TERM_CONTEXT) {
+    _termTranslations.insert(term, termResult);
+  } else if (formulaResult->connective() == LITERAL) {
+    _literalTranslations.insert(term, formulaResult->literal());
+  }
+}
+
+/**
+ * Build the beginning of a key of _definedSymbols from the kind of the
+ * defined term, the context and the free variables of the term together with
+ * their sorts. The variables are included because the fresh symbol is applied
+ * to them in the same order in every occurrence of the term.
+ */
+vstring FOOLElimination::definitionKey(const char* kind, Context context, Formula::VarList* vars) {
+  CALL("FOOLElimination::definitionKey");
+
+  vstring key = kind;
+  key += context == FORMULA_CONTEXT ? "f(" : "t(";
+  Formula::VarList::Iterator vit(vars);
+  while (vit.hasNext()) {
+    unsigned var = (unsigned)vit.next();
+    key += Int::toString(var) + ":" + Int::toString(_varSorts.get(var)) + ",";
+  }
+  key += ")";
+  return key;
+}
+
 /**
  * A shortcut of process(Term*, context) for TERM_CONTEXT.
  */
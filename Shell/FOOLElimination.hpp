@@ -26,6 +26,8 @@
 
 #include "Forwards.hpp"
 
+#include "Lib/DHMap.hpp"
+
 using namespace Kernel;
 using namespace Shell;
 
@@ -62,6 +64,21 @@ private:
   /** Lexical scope of the current unit */
   DHMap<unsigned,unsigned> _varSorts;
 
+  /**
+   * Translations of the unshared terms of the current unit, so that a term
+   * occurring several times in the unit is only processed once. Results in
+   * the formula context are only remembered when they are atomic.
+   */
+  DHMap<Term*,TermList> _termTranslations;
+  DHMap<Term*,Literal*> _literalTranslations;
+
+  /**
+   * Symbols defined for $ite-terms, formulas in term context and $let-bindings,
+   * indexed by a key built from their processed parts. Kept across units, so
+   * that every distinct term gets exactly one definition.
+   */
+  DHMap<vstring,unsigned> _definedSymbols;
+
   /** Process a given part of the unit */
   FormulaList* process(FormulaList* fs);
   Formula* process(Formula* f);
@@ -71,6 +88,14 @@ private:
   static const Context TERM_CONTEXT = true;
   static const Context FORMULA_CONTEXT = false;
 
+  // Lookup and recording of the translations of the current unit
+  bool findTranslation(Term* term, Context context, TermList& termResult, Formula*& formulaResult);
+  void rememberTranslation(Term* term, Context context, TermList termResult, Formula* formulaResult);
+
+  // Builds the key under which the symbol defined for a term is stored in
+  // _definedSymbols. The processed parts of the term are appended by the caller
+  vstring definitionKey(const char* kind, Context context, Formula::VarList* vars);
+
   // Processing of TermList and Term* returns a TermList or a Formula*,
   // depending on the context
   void process(TermList ts, Context context, TermList& termResult, Formula*& formulaResult);
@@ -36,9 +36,10 @@ namespace Shell {
 using namespace Lib;
 using namespace Kernel;
 
-LispParser::LispParser(LispLexer& lexer)
+LispParser::LispParser(LispLexer& lexer, bool shareAtoms)
   : _lexer(lexer),
-    _balance(0)
+    _balance(0),
+    _shareAtoms(shareAtoms)
 {}
 
 /**
@@ -145,7 +146,17 @@ void LispParser::parse(List** expr0)
       case TT_INTEGER:
       case TT_REAL:
       {
-        Expression* subexpr = new Expression(ATOM,t.text);
+        Expression* subexpr;
+        if (_shareAtoms) {
+          Expression** pAtom;
+          if (_atoms.getValuePtr(t.text, pAtom)) {
+            *pAtom = new Expression(ATOM,t.text);
+          }
+          subexpr = *pAtom;
+        }
+        else {
+          subexpr = new Expression(ATOM,t.text);
+        }
         List* sub = new List(subexpr);
         *expr = sub;
         expr = sub->tailPtr();
@@ -387,15 +398,14 @@ bool LispListReader::tryReadAtom(vstring& atom)
   return false;
 }
 
-vstring LispListReader::readAtom()
+const vstring& LispListReader::readAtom()
 {
   CALL("LispListReader::readAtom");
 
-  vstring atm;
-  if(!tryReadAtom(atm)) {
+  if(!hasNext() || !peekAtNext()->isAtom()) {
     lispCurrError("atom expected");
   }
-  return atm;
+  return readNext()->str;
 }
 
 bool LispListReader::tryAcceptAtom(vstring atom)
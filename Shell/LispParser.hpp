@@ -29,6 +29,7 @@
 #include "Forwards.hpp"
 #include "Token.hpp"
 
+#include "Lib/DHMap.hpp"
 #include "Lib/Exception.hpp"
 #include "Lib/List.hpp"
 #include "Lib/Portability.hpp"
@@ -93,7 +94,7 @@ public:
 
   typedef Lib::List<Expression*> List;
 
-  explicit LispParser(LispLexer& lexer);
+  explicit LispParser(LispLexer& lexer, bool shareAtoms=false);
   Expression* parse();
   void parse(List**);
 
@@ -117,6 +118,13 @@ private:
   LispLexer& _lexer;
   /** balance of parenthesis */
   int _balance;
+  /**
+   * If true, all occurrences of an atom are represented by the same
+   * Expression object, stored in _atoms. Only for clients that neither
+   * modify the expressions nor use them as keys of maps.
+   */
+  bool _shareAtoms;
+  Lib::DHMap<vstring,Expression*> _atoms;
 }; // class LispParser
 
 typedef LispParser::Expression LExpr;
@@ -144,7 +152,7 @@ public:
   LExpr* next() { return readNext(); }
 
   bool tryReadAtom(vstring& atom);
-  vstring readAtom();
+  const vstring& readAtom();
 
   bool tryReadListExpr(LExpr*& e);
   LExpr* readListExpr();
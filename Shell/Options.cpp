@@ -120,6 +120,7 @@ void Options::Options::init()
                                         "profile",
                                         "random_strategy",
                                         "sat_solver",
+                                        "server",
                                         "smtcomp",
                                         "spider",
                                         "tclausify",
@@ -132,6 +133,10 @@ void Options::Options::init()
     "  -preprocess,axiom_select,clausify,grounding: modes for producing output\n   for other solvers.\n"
     "  -output,profile: output information about the problem\n"
     "  -sat_solver: accepts problems in DIMACS and uses the internal sat solver\n   directly\n"
+    "  -server: reads jobs from the standard input. A job is a line of options,\n"
+    "   followed by the problem and a line containing a single '.', unless the\n"
+    "   options name a problem file. Each job runs in a process forked from the\n"
+    "   server and its output is followed by the line '%%% done <exit status>'\n"
     "Some modes are not currently maintained:\n"
     "  -bpa: perform bound propagation\n"
     "  -consequence_elimination: perform consequence elimination\n"
@@ -533,6 +538,15 @@ void Options::Options::init()
     _lookup.insert(&_newCNF);
     _newCNF.tag(OptionTag::PREPROCESSING);
 
+    _newCNFWorkers = UnsignedOptionValue("newcnf_workers","",1);
+    _newCNFWorkers.description="Number of forked processes the formulas are split between for clausification by NewCNF. "
+                               "The clauses are merged back in the order of the input formulas.";
+    _lookup.insert(&_newCNFWorkers);
+    _newCNFWorkers.tag(OptionTag::PREPROCESSING);
+    _newCNFWorkers.setExperimental();
+    _newCNFWorkers.addHardConstraint(greaterThan(0u));
+    _newCNFWorkers.reliesOn(_newCNF.is(equal(true)));
+
     _iteInliningThreshold = IntOptionValue("ite_inlining_threshold","", 0);
     _iteInliningThreshold.description="Threashold of inlining of if-then-else expressions. "
                                       "0 means that all expressions are named. "
@@ -565,6 +579,13 @@ void Options::Options::init()
     _lookup.insert(&_latexOutput);
     _latexOutput.tag(OptionTag::OUTPUT);
 
+    _startupProfile = StringOptionValue("startup_profile","","off");
+    _startupProfile.description="File to which a JSON profile of the run is written when statistics are printed."
+        " It contains the time and peak allocator memory of each execution phase (sampled every millisecond)"
+        " and the time of the first clause activation.";
+    _lookup.insert(&_startupProfile);
+    _startupProfile.tag(OptionTag::OUTPUT);
+
     _latexUseDefaultSymbols = BoolOptionValue("latex_use_default_symbols","",true);
     _latexUseDefaultSymbols.description="Interpretted symbols such as product have default LaTeX symbols"
         " that can be used. They can be overriden in the normal way. This option can turn them off";
@@ -764,6 +785,18 @@ void Options::Options::init()
     _fmbSizeWeightRatio.setExperimental();
     _lookup.insert(&_fmbSizeWeightRatio);
 
+    _fmbLazyInstances = BoolOptionValue("fmb_lazy_instances","fmbli",false);
+    _fmbLazyInstances.description = "Do not ground the non-ground clauses eagerly. Only add the instances that are false in the current SAT model"
+        " and solve again, until the model satisfies all instances or the instances are unsatisfiable.";
+    _fmbLazyInstances.setExperimental();
+    _lookup.insert(&_fmbLazyInstances);
+
+    _fmbIncremental = BoolOptionValue("fmb_incremental","fmbinc",false);
+    _fmbIncremental.description = "Keep the SAT solver, with its learnt clauses, when the model sizes grow."
+        " Only the new instances are added and the constraints specific to a size are guarded by assumptions.";
+    _fmbIncremental.setExperimental();
+    _lookup.insert(&_fmbIncremental);
+
     _fmbEnumerationStrategy = ChoiceOptionValue<FMBEnumerationStrategy>("fmb_enumeration_strategy","fmbes",FMBEnumerationStrategy::SBMEAM,{"sbeam",
 #if VZ3
         "smt",
@@ -803,6 +836,15 @@ void Options::Options::init()
     _lookaheadDelay.tag(OptionTag::SATURATION);
     _lookup.insert(&_lookaheadDelay);
     _lookaheadDelay.reliesOn(_selection.isLookAheadSelection());
+
+    _lookaheadEstimate = BoolOptionValue("lookahead_estimate","lse",false);
+    _lookaheadEstimate.description = "Instead of enumerating the inferences each literal would take part in,"
+                                     " lookahead selection estimates their number from the number of index"
+                                     " entries with the same top symbol, which the indices keep up to date";
+    _lookaheadEstimate.tag(OptionTag::SATURATION);
+    _lookaheadEstimate.setExperimental();
+    _lookup.insert(&_lookaheadEstimate);
+    _lookaheadEstimate.reliesOn(_selection.isLookAheadSelection());
     
     _ageWeightRatio = RatioOptionValue("age_weight_ratio","awr",1,1,':');
     _ageWeightRatio.description=
@@ -813,11 +855,42 @@ void Options::Options::init()
     _ageWeightRatio.reliesOn(_saturationAlgorithm.is(notEqual(SaturationAlgorithm::INST_GEN))->Or<int>(_instGenWithResolution.is(equal(true))));
     _ageWeightRatio.setRandomChoices({"8:1","5:1","4:1","3:1","2:1","3:2","5:4","1","2:3","2","3","4","5","6","7","8","10","12","14","16","20","24","28","32","40","50","64","128","1024"});
 
+    _clauseQueues = StringOptionValue("clause_queues","cq","");
+    _clauseQueues.description=
+    "Select passive clauses from several queues instead of the age and weight queues of age_weight_ratio. "
+    "The value is a comma separated list of queue:ratio pairs, where queue is one of age, weight, goal "
+    "(clauses derived from the goal first), theory (clauses not descending from theory axioms first) and "
+    "splits (clauses depending on fewer AVATAR splits first) and symbols (lighter clauses first, "
+    "with the symbols weighted as given by symbol_weighting), e.g. age:1,weight:5,goal:2. "
+    "Ties within a queue are broken by weight and age. With the lrs saturation algorithm, the age limit "
+    "follows the age queue and the weight limit all the other queues.";
+    _lookup.insert(&_clauseQueues);
+    _clauseQueues.tag(OptionTag::SATURATION);
+    _clauseQueues.setExperimental();
+
+    _symbolWeighting = ChoiceOptionValue<SymbolWeighting>("symbol_weighting","swt",SymbolWeighting::OFF,{"off","frequency","goal"});
+    _symbolWeighting.description=
+    "Weights of symbols used by the symbols clause queue (see clause_queues). "
+    "frequency makes symbols occurring less often in the preprocessed problem heavier, "
+    "goal makes symbols heavier the further they are from the goal symbols in the SInE sense. "
+    "With off, each symbol has weight 1.";
+    _lookup.insert(&_symbolWeighting);
+    _symbolWeighting.tag(OptionTag::SATURATION);
+    _symbolWeighting.setExperimental();
+
 	    _literalMaximalityAftercheck = BoolOptionValue("literal_maximality_aftercheck","lma",false);
 	    _lookup.insert(&_literalMaximalityAftercheck);
 	    _literalMaximalityAftercheck.tag(OptionTag::SATURATION);
 	    _literalMaximalityAftercheck.setExperimental();
 
+	    _pushGeneratedClauses = BoolOptionValue("push_generated_clauses","pgc",true);
+	    _pushGeneratedClauses.description=
+	    "Let the generating inferences pass their conclusions directly to the saturation loop"
+	    " instead of returning them through a chain of iterators. The generated clauses are the same.";
+	    _lookup.insert(&_pushGeneratedClauses);
+	    _pushGeneratedClauses.tag(OptionTag::SATURATION);
+	    _pushGeneratedClauses.setExperimental();
+
 	    _lrsFirstTimeCheck = IntOptionValue("lrs_first_time_check","",5);
 	    _lrsFirstTimeCheck.description=
 	    "Percentage of time limit at which the LRS algorithm will for the first time estimate the number of reachable clauses.";
@@ -832,6 +905,16 @@ void Options::Options::init()
 	    _lookup.insert(&_lrsWeightLimitOnly);
 	    _lrsWeightLimitOnly.tag(OptionTag::LRS);
 
+	    _lrsSpillLimit = UnsignedOptionValue("lrs_spill_limit","lsl",0);
+	    _lrsSpillLimit.description=
+	    "Percentage of the memory limit up to which the passive clauses the LRS algorithm removes when it tightens its limits are kept in memory instead of being discarded."
+	    " The set aside clauses are added again when the limits are relaxed or when the passive container runs out of clauses."
+	    " Once the memory use exceeds the percentage, the set aside clauses are discarded; nothing is written to disk. If 0, the clauses are discarded immediately.";
+	    _lookup.insert(&_lrsSpillLimit);
+	    _lrsSpillLimit.tag(OptionTag::LRS);
+	    _lrsSpillLimit.addConstraint(lessThanEq(100u));
+	    _lrsSpillLimit.setExperimental();
+
 	    _simulatedTimeLimit = TimeLimitOptionValue("simulated_time_limit","stl",0);
 	    _simulatedTimeLimit.description=
 	    "Time limit in seconds for the purpose of reachability estimations of the LRS saturation algorithm (if 0, the actual time limit is used)";
@@ -897,6 +980,27 @@ void Options::Options::init()
 	    _backwardSubsumptionResolution.reliesOn(_saturationAlgorithm.is(notEqual(SaturationAlgorithm::INST_GEN))->Or<Subsumption>(_instGenWithResolution.is(equal(true))));
 	    _backwardSubsumptionResolution.setRandomChoices({"on","off"});
 
+	    _subsumptionFeatureFilter = BoolOptionValue("subsumption_feature_filter","sff",false);
+	    _subsumptionFeatureFilter.description=
+		     "Before attempting multi-literal matching in forward and backward subsumption, compare cheap clause "
+		     "features (literal counts and symbol occurrences per polarity, depth, occurring symbols) kept in a "
+		     "feature index and skip candidates that cannot subsume.";
+	    _lookup.insert(&_subsumptionFeatureFilter);
+	    _subsumptionFeatureFilter.tag(OptionTag::INFERENCES);
+	    _subsumptionFeatureFilter.setExperimental();
+
+	    _backwardSimplificationBatch = UnsignedOptionValue("backward_simplification_batch","bsb",0);
+	    _backwardSimplificationBatch.description=
+		     "Collect clauses that should be used for backward simplification and perform the backward "
+		     "simplifications with the whole batch at once, once the batch reaches the given size (or the "
+		     "passive container is exhausted). A clause rewritten or deleted by one member of the batch is "
+		     "then not retrieved again by the others. If zero, backward simplification is performed for each clause immediately.";
+	    _lookup.insert(&_backwardSimplificationBatch);
+	    _backwardSimplificationBatch.tag(OptionTag::INFERENCES);
+	    _backwardSimplificationBatch.setExperimental();
+	    _backwardSimplificationBatch.addConstraint(notEqual(1u));
+	    _backwardSimplificationBatch.reliesOn(_saturationAlgorithm.is(notEqual(SaturationAlgorithm::INST_GEN)));
+
 	    _binaryResolution = BoolOptionValue("binary_resolution","br",true);
 	    _binaryResolution.description=
 		  "Standard binary resolution i.e.\n"
@@ -1024,6 +1128,15 @@ void Options::Options::init()
 	    _lookup.insert(&_forwardDemodulation);
 	    _forwardDemodulation.tag(OptionTag::INFERENCES);
 	    _forwardDemodulation.setRandomChoices({"all","all","all","off","preordered"});
+
+	    _demodulationNormalFormCache = BoolOptionValue("demodulation_normal_form_cache","dnfc",false);
+	    _demodulationNormalFormCache.description=
+	    "Remember shared terms that forward demodulation failed to rewrite and skip them (with all their "
+	    "subterms) until a new rewrite rule is added to the demodulation index.";
+	    _lookup.insert(&_demodulationNormalFormCache);
+	    _demodulationNormalFormCache.tag(OptionTag::INFERENCES);
+	    _demodulationNormalFormCache.setExperimental();
+	    _demodulationNormalFormCache.reliesOn(_forwardDemodulation.is(notEqual(Demodulation::OFF)));
     
     _forwardLiteralRewriting = BoolOptionValue("forward_literal_rewriting","flr",false);
     _forwardLiteralRewriting.description="Perform forward literal rewriting.";
@@ -1190,6 +1303,12 @@ void Options::Options::init()
     _useHashingVariantIndex.setExperimental();
     _useHashingVariantIndex.setRandomChoices({"on","off"});
 
+    _groundEntryIndexing = BoolOptionValue("ground_entry_indexing","gei",false);
+    _groundEntryIndexing.description= "Additionally keep the ground entries of term and literal substitution trees in hash tables, so that retrievals for ground queries that can only return equal entries are answered without traversing the tree.";
+    _lookup.insert(&_groundEntryIndexing);
+    _groundEntryIndexing.tag(OptionTag::OTHER);
+    _groundEntryIndexing.setExperimental();
+
     /*
     _use_dm = BoolOptionValue("use_dismatching","dm",false);
     _use_dm.description="Use dismatching constraints.";
@@ -1373,7 +1492,7 @@ void Options::Options::init()
     _satClauseActivityDecay.setExperimental();
 
     _satClauseDisposer = ChoiceOptionValue<SatClauseDisposer>("sat_clause_disposer","",SatClauseDisposer::MINISAT,
-                                                              {"growing","minisat"});
+                                                              {"growing","minisat","lbd"});
     _satClauseDisposer.description="";
     _lookup.insert(&_satClauseDisposer);
     _satClauseDisposer.tag(OptionTag::SAT);
@@ -1391,6 +1510,13 @@ void Options::Options::init()
     _satLearntSubsumptionResolution.tag(OptionTag::SAT);
     _satLearntSubsumptionResolution.setExperimental();
 
+    _satInprocessing = BoolOptionValue("sat_inprocessing","",false);
+    _satInprocessing.description="Periodically simplify the learnt clauses of the vampire SAT solver"
+                                 " by subsumption and vivification (only done when no assumptions are set).";
+    _lookup.insert(&_satInprocessing);
+    _satInprocessing.tag(OptionTag::SAT);
+    _satInprocessing.setExperimental();
+
     _satRestartFixedCount = IntOptionValue("sat_restart_fixed_count","",16000);
     _satRestartFixedCount.description="";
     _lookup.insert(&_satRestartFixedCount);
@@ -1453,6 +1579,22 @@ void Options::Options::init()
             {"minisat","vampire"});
 #endif
 
+    _satBenchmark = StringOptionValue("sat_benchmark","","off");
+    _satBenchmark.description="In the sat_solver mode, run each of the given comma-separated SAT solver back ends"
+        " (vampire, minisat, minisat_simp, buffered) on the input, which can be a DIMACS file, a SAT trace written"
+        " with sat_trace or a directory of *.cnf and *.trace files, and print solve time, conflicts, propagations and peak memory of each run as a JSON line.";
+    _lookup.insert(&_satBenchmark);
+    _satBenchmark.tag(OptionTag::SAT);
+    _satBenchmark.setExperimental();
+
+    _satTrace = StringOptionValue("sat_trace","","off");
+    _satTrace.description="Write a binary trace of the calls made to the SAT solvers used by splitting, global subsumption"
+        " and finite model building. Each solver gets its own file named <value>_<client>_<n>.trace. The traces can be"
+        " replayed against any back end by giving them to the sat_solver mode with sat_benchmark.";
+    _lookup.insert(&_satTrace);
+    _satTrace.tag(OptionTag::SAT);
+    _satTrace.setExperimental();
+
 #if VZ3
     _satFallbackForSMT = BoolOptionValue("sat_fallback_for_smt","sffsmt",false);
     _satFallbackForSMT.description="If using z3 run a sat solver alongside to use if the smt"
@@ -1583,6 +1725,13 @@ void Options::Options::init()
     _termOrdering.description="The term ordering used by Vampire to orient equations and order literals";
     _termOrdering.tag(OptionTag::SATURATION);
     _lookup.insert(&_termOrdering);
+
+    _orderingCacheSize = UnsignedOptionValue("ordering_cache_size","ocs",0);
+    _orderingCacheSize.description="Number of entries of the cache of term ordering comparisons between shared terms. The cache is direct mapped, so each comparison replaces the previous one mapped to its entry. The number is rounded up to a power of two, 0 disables the cache.";
+    _orderingCacheSize.tag(OptionTag::SATURATION);
+    _orderingCacheSize.setExperimental();
+    _lookup.insert(&_orderingCacheSize);
+
     _symbolPrecedence = ChoiceOptionValue<SymbolPrecedence>("symbol_precedence","sp",SymbolPrecedence::ARITY,
                                                             {"arity","occurrence","reverse_arity","scramble",
                                                              "frequency","reverse_frequency",
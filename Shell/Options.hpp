@@ -386,6 +386,7 @@ public:
     PROFILE,
     RANDOM_STRATEGY,
     SAT,
+    SERVER,
     SMTCOMP,
     SPIDER,
     TCLAUSIFY,
@@ -558,6 +559,11 @@ public:
     UNIT = 2,
     GOAL_UNIT = 3
   };
+  enum class SymbolWeighting : unsigned int {
+    OFF = 0,
+    FREQUENCY = 1,
+    GOAL = 2
+  };
 
   enum class SineSelection : unsigned int {
     AXIOMS = 0,
@@ -614,6 +620,7 @@ public:
   enum class SatClauseDisposer : unsigned int {
     GROWING = 0,
     MINISAT = 1,
+    LBD = 2,
   };
   
   enum class SplittingLiteralPolarityAdvice : unsigned int {
@@ -1792,12 +1799,15 @@ public:
   bool fmbDetectSortBounds() const { return _fmbDetectSortBounds.actualValue; }
   unsigned fmbDetectSortBoundsTimeLimit() const { return _fmbDetectSortBoundsTimeLimit.actualValue; }
   unsigned fmbSizeWeightRatio() const { return _fmbSizeWeightRatio.actualValue; }
+  bool fmbLazyInstances() const { return _fmbLazyInstances.actualValue; }
+  bool fmbIncremental() const { return _fmbIncremental.actualValue; }
   FMBEnumerationStrategy fmbEnumerationStrategy() const { return _fmbEnumerationStrategy.actualValue; }
 
   bool flattenTopLevelConjunctions() const { return _flattenTopLevelConjunctions.actualValue; }
   LTBLearning ltbLearning() const { return _ltbLearning.actualValue; }
   vstring ltbDirectory() const { return _ltbDirectory.actualValue; }
   Mode mode() const { return _mode.actualValue; }
+  void setMode(Mode newVal) { _mode.actualValue = newVal; }
   Schedule schedule() const { return _schedule.actualValue; }
   vstring scheduleName() const { return _schedule.getStringOfValue(_schedule.actualValue); }
   void setSchedule(Schedule newVal) {  _schedule.actualValue = newVal; }
@@ -1863,17 +1873,21 @@ public:
   bool weightIncrement() const { return _weightIncrement.actualValue; }
   // bool useDM() const { return _use_dm.actualValue; }
   SatSolver satSolver() const { return _satSolver.actualValue; }
+  vstring satBenchmark() const { return _satBenchmark.actualValue; }
+  vstring satTrace() const { return _satTrace.actualValue; }
   //void setSatSolver(SatSolver newVal) { _satSolver = newVal; }
   SaturationAlgorithm saturationAlgorithm() const { return _saturationAlgorithm.actualValue; }
   void setSaturationAlgorithm(SaturationAlgorithm newVal) { _saturationAlgorithm.actualValue = newVal; }
   int selection() const { return _selection.actualValue; }
   void setSelection(int v) { _selection.actualValue=v;}
   vstring latexOutput() const { return _latexOutput.actualValue; }
+  vstring startupProfile() const { return _startupProfile.actualValue; }
   bool latexUseDefault() const { return _latexUseDefaultSymbols.actualValue; }
   LiteralComparisonMode literalComparisonMode() const { return _literalComparisonMode.actualValue; }
   bool forwardSubsumptionResolution() const { return _forwardSubsumptionResolution.actualValue; }
   //void setForwardSubsumptionResolution(bool newVal) { _forwardSubsumptionResolution = newVal; }
   Demodulation forwardDemodulation() const { return _forwardDemodulation.actualValue; }
+  bool demodulationNormalFormCache() const { return _demodulationNormalFormCache.actualValue; }
   bool binaryResolution() const { return _binaryResolution.actualValue; }
   bool bfnt() const { return _bfnt.actualValue; }
   void setBfnt(bool newVal) { _bfnt.actualValue = newVal; }
@@ -1889,15 +1903,20 @@ public:
   Subsumption backwardSubsumption() const { return _backwardSubsumption.actualValue; }
   //void setBackwardSubsumption(Subsumption newVal) { _backwardSubsumption = newVal; }
   Subsumption backwardSubsumptionResolution() const { return _backwardSubsumptionResolution.actualValue; }
+  unsigned backwardSimplificationBatch() const { return _backwardSimplificationBatch.actualValue; }
+  bool subsumptionFeatureFilter() const { return _subsumptionFeatureFilter.actualValue; }
   bool forwardSubsumption() const { return _forwardSubsumption.actualValue; }
   bool forwardLiteralRewriting() const { return _forwardLiteralRewriting.actualValue; }
   int lrsFirstTimeCheck() const { return _lrsFirstTimeCheck.actualValue; }
   int lrsWeightLimitOnly() const { return _lrsWeightLimitOnly.actualValue; }
+  unsigned lrsSpillLimit() const { return _lrsSpillLimit.actualValue; }
   int lookaheadDelay() const { return _lookaheadDelay.actualValue; }
+  bool lookaheadEstimate() const { return _lookaheadEstimate.actualValue; }
   int simulatedTimeLimit() const { return _simulatedTimeLimit.actualValue; }
   void setSimulatedTimeLimit(int newVal) { _simulatedTimeLimit.actualValue = newVal; }
   int maxInferenceDepth() const { return _maxInferenceDepth.actualValue; }
   TermOrdering termOrdering() const { return _termOrdering.actualValue; }
+  unsigned orderingCacheSize() const { return _orderingCacheSize.actualValue; }
   SymbolPrecedence symbolPrecedence() const { return _symbolPrecedence.actualValue; }
   SymbolPrecedenceBoost symbolPrecedenceBoost() const { return _symbolPrecedenceBoost.actualValue; }
   const vstring& functionPrecedence() const { return _functionPrecedence.actualValue; }
@@ -1915,7 +1934,10 @@ public:
   void setAgeRatio(int v){ _ageWeightRatio.actualValue = v; }
   int weightRatio() const { return _ageWeightRatio.otherValue; }
   void setWeightRatio(int v){ _ageWeightRatio.otherValue = v; }
+  const vstring& clauseQueues() const { return _clauseQueues.actualValue; }
+  SymbolWeighting symbolWeighting() const { return _symbolWeighting.actualValue; }
   bool literalMaximalityAftercheck() const { return _literalMaximalityAftercheck.actualValue; }
+  bool pushGeneratedClauses() const { return _pushGeneratedClauses.actualValue; }
   bool superpositionFromVariables() const { return _superpositionFromVariables.actualValue; }
   EqualityProxy equalityProxy() const { return _equalityProxy.actualValue; }
   RuleActivity equalityResolutionWithDeletion() const { return _equalityResolutionWithDeletion.actualValue; }
@@ -1981,11 +2003,13 @@ public:
   int instGenSelection() const { return _instGenSelection.actualValue; }
   bool instGenWithResolution() const { return _instGenWithResolution.actualValue; }
   bool useHashingVariantIndex() const { return _useHashingVariantIndex.actualValue; }
+  bool groundEntryIndexing() const { return _groundEntryIndexing.actualValue; }
 
   float satClauseActivityDecay() const { return _satClauseActivityDecay.actualValue; }
   SatClauseDisposer satClauseDisposer() const { return _satClauseDisposer.actualValue; }
   bool satLearntMinimization() const { return _satLearntMinimization.actualValue; }
   bool satLearntSubsumptionResolution() const { return _satLearntSubsumptionResolution.actualValue; }
+  bool satInprocessing() const { return _satInprocessing.actualValue; }
   int satRestartFixedCount() const { return _satRestartFixedCount.actualValue; }
   float satRestartGeometricIncrease() const { return _satRestartGeometricIncrease.actualValue; }
   int satRestartGeometricInit() const { return _satRestartGeometricInit.actualValue; }
@@ -2041,6 +2065,7 @@ public:
   bool bpStartWithRational() const { return _bpStartWithRational.actualValue;}
     
   bool newCNF() const { return _newCNF.actualValue; }
+  unsigned newCNFWorkers() const { return _newCNFWorkers.actualValue; }
   int getIteInliningThreshold() const { return _iteInliningThreshold.actualValue; }
   bool getIteInlineLet() const { return _inlineLet.actualValue; }
 private:
@@ -2151,7 +2176,10 @@ private:
   BoolOptionValue _encode;
 
   RatioOptionValue _ageWeightRatio;
+  StringOptionValue _clauseQueues;
+  ChoiceOptionValue<SymbolWeighting> _symbolWeighting;
   BoolOptionValue _literalMaximalityAftercheck;
+  BoolOptionValue _pushGeneratedClauses;
   BoolOptionValue _arityCheck;
   
   BoolOptionValue _backjumpTargetIsDecisionPoint;
@@ -2159,6 +2187,8 @@ private:
   ChoiceOptionValue<Demodulation> _backwardDemodulation;
   ChoiceOptionValue<Subsumption> _backwardSubsumption;
   ChoiceOptionValue<Subsumption> _backwardSubsumptionResolution;
+  UnsignedOptionValue _backwardSimplificationBatch;
+  BoolOptionValue _subsumptionFeatureFilter;
   BoolOptionValue _bfnt;
   BoolOptionValue _binaryResolution;
   BoolOptionValue _bpCollapsingPropagation;
@@ -2177,6 +2207,7 @@ private:
   ChoiceOptionValue<Condensation> _condensation;
 
   BoolOptionValue _demodulationRedundancyCheck;
+  BoolOptionValue _demodulationNormalFormCache;
 
   ChoiceOptionValue<EqualityProxy> _equalityProxy;
   ChoiceOptionValue<RuleActivity> _equalityResolutionWithDeletion;
@@ -2199,6 +2230,8 @@ private:
   BoolOptionValue _fmbDetectSortBounds;
   UnsignedOptionValue _fmbDetectSortBoundsTimeLimit;
   UnsignedOptionValue _fmbSizeWeightRatio;
+  BoolOptionValue _fmbLazyInstances;
+  BoolOptionValue _fmbIncremental;
   ChoiceOptionValue<FMBEnumerationStrategy> _fmbEnumerationStrategy;
 
   BoolOptionValue _flattenTopLevelConjunctions;
@@ -2243,16 +2276,20 @@ private:
   FloatOptionValue _instGenRestartPeriodQuotient;
   BoolOptionValue _instGenWithResolution;
   BoolOptionValue _useHashingVariantIndex;
+  BoolOptionValue _groundEntryIndexing;
   BoolOptionValue _interpretedSimplification;
 
   StringOptionValue _latexOutput;
+  StringOptionValue _startupProfile;
   BoolOptionValue _latexUseDefaultSymbols;
 
   ChoiceOptionValue<LiteralComparisonMode> _literalComparisonMode;
   StringOptionValue _logFile;
   IntOptionValue _lookaheadDelay;
+  BoolOptionValue _lookaheadEstimate;
   IntOptionValue _lrsFirstTimeCheck;
   BoolOptionValue _lrsWeightLimitOnly;
+  UnsignedOptionValue _lrsSpillLimit;
   ChoiceOptionValue<LTBLearning> _ltbLearning;
   StringOptionValue _ltbDirectory;
 
@@ -2294,6 +2331,7 @@ private:
   ChoiceOptionValue<SatClauseDisposer> _satClauseDisposer;
   BoolOptionValue _satLearntMinimization;
   BoolOptionValue _satLearntSubsumptionResolution;
+  BoolOptionValue _satInprocessing;
   IntOptionValue _satRestartFixedCount;
   FloatOptionValue _satRestartGeometricIncrease;
   IntOptionValue _satRestartGeometricInit;
@@ -2304,6 +2342,8 @@ private:
   FloatOptionValue _satVarActivityDecay;
   ChoiceOptionValue<SatVarSelector> _satVarSelector;
   ChoiceOptionValue<SatSolver> _satSolver;
+  StringOptionValue _satBenchmark;
+  StringOptionValue _satTrace;
   ChoiceOptionValue<SaturationAlgorithm> _saturationAlgorithm;
   BoolOptionValue _selectUnusedVariablesFirst;
   BoolOptionValue _showAll;
@@ -2363,6 +2403,7 @@ private:
   ChoiceOptionValue<Statistics> _statistics;
   BoolOptionValue _superpositionFromVariables;
   ChoiceOptionValue<TermOrdering> _termOrdering;
+  UnsignedOptionValue _orderingCacheSize;
   ChoiceOptionValue<SymbolPrecedence> _symbolPrecedence;
   ChoiceOptionValue<SymbolPrecedenceBoost> _symbolPrecedenceBoost;
   StringOptionValue _functionPrecedence;
@@ -2398,6 +2439,7 @@ private:
   InputFileOptionValue _inputFile;
 
   BoolOptionValue _newCNF;
+  UnsignedOptionValue _newCNFWorkers;
   IntOptionValue _iteInliningThreshold;
   BoolOptionValue _inlineLet;
 
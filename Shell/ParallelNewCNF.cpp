@@ -0,0 +1,530 @@
+/*
+ * File ParallelNewCNF.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file ParallelNewCNF.cpp
+ * Implements class ParallelNewCNF running NewCNF in forked worker processes.
+ */
+
+#include <errno.h>
+
+#include "Debug/Tracer.hpp"
+
+#include "Lib/Environment.hpp"
+#include "Lib/Exception.hpp"
+#include "Lib/System.hpp"
+#include "Lib/Sys/Multiprocessing.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Formula.hpp"
+#include "Kernel/FormulaUnit.hpp"
+#include "Kernel/Inference.hpp"
+#include "Kernel/SortHelper.hpp"
+#include "Kernel/Sorts.hpp"
+
+#include "NewCNF.hpp"
+#include "Options.hpp"
+#include "Statistics.hpp"
+
+#include "ParallelNewCNF.hpp"
+
+namespace Shell {
+
+using namespace Lib::Sys;
+
+/**
+ * Return true if the workers can do the clausification in the current
+ * environment
+ *
+ * The [PP] output of the workers would be interleaved, and the colours and
+ * LaTeX names of the introduced symbols are not passed back to the parent.
+ */
+bool ParallelNewCNF::canShard()
+{
+  CALL("ParallelNewCNF::canShard");
+
+  return !env.options->showPreprocessing() && !env.colorUsed &&
+      env.options->latexOutput()=="off";
+}
+
+/**
+ * Replace each formula in @b units by its clauses, return false if
+ * nothing was done, because there is not enough formulas for more than
+ * one worker or the clausification cannot be sharded
+ *
+ * The clauses of each formula are inserted in its place in the same
+ * order as in Preprocess::newCnf.
+ */
+bool ParallelNewCNF::clausify(UnitList*& units)
+{
+  CALL("ParallelNewCNF::clausify");
+
+  if (!canShard()) {
+    return false;
+  }
+
+  UnitList::Iterator uit(units);
+  while (uit.hasNext()) {
+    Unit* u = uit.next();
+    if (!u->isClause()) {
+      _formulas.push(static_cast<FormulaUnit*>(u));
+    }
+  }
+  unsigned workers = std::min(_workers, (unsigned)_formulas.size());
+  if (workers < 2) {
+    return false;
+  }
+
+  _shardStarts.ensure(workers+1);
+  for (unsigned i = 0; i <= workers; i++) {
+    _shardStarts[i] = (unsigned)((size_t)_formulas.size()*i/workers);
+  }
+  _functions = env.signature->functions();
+  _predicates = env.signature->predicates();
+
+  DArray<unsigned> freshCnts(workers);
+  unsigned freshTotal = 0;
+  for (unsigned i = 0; i < workers; i++) {
+    freshCnts[i] = 0;
+    for (unsigned j = _shardStarts[i]; j < _shardStarts[i+1]; j++) {
+      freshCnts[i] += freshNumberBound(_formulas[j]);
+    }
+    freshTotal += freshCnts[i];
+  }
+  int firstFresh = env.signature->reserveFreshSymbolNumbers(freshTotal);
+
+  DArray<FILE*> files(workers);
+  DArray<pid_t> workerIds(workers);
+  for (unsigned i = 0; i < workers; i++) {
+    files[i] = tmpfile();
+    if (!files[i]) {
+      SYSTEM_FAIL("Cannot create a clausification shard file.",errno);
+    }
+    pid_t pid = Multiprocessing::instance()->fork();
+    if (!pid) {
+      runWorker(i, firstFresh, freshCnts[i], files[i]);
+    }
+    workerIds[i] = pid;
+    firstFresh += freshCnts[i];
+  }
+
+  for (unsigned i = 0; i < workers; i++) {
+    int resValue;
+    Multiprocessing::instance()->waitForParticularChildTermination(workerIds[i], resValue);
+    if (!resValue) {
+      rewind(files[i]);
+    }
+    if (resValue || !readShard(i, files[i])) {
+      clausifyShard(i);
+    }
+    fclose(files[i]);
+  }
+  ASS_EQ(_clauseEnds.size(), _formulas.size());
+
+  unsigned formulaIdx = 0;
+  unsigned clauseIdx = 0;
+  UnitList::DelIterator us(units);
+  while (us.hasNext()) {
+    Unit* u = us.next();
+    if (u->isClause()) {
+      continue;
+    }
+    ASS_EQ(u, _formulas[formulaIdx]);
+    for (; clauseIdx < _clauseEnds[formulaIdx]; clauseIdx++) {
+      us.insert(_clauses[clauseIdx]);
+    }
+    us.del();
+    formulaIdx++;
+  }
+  return true;
+} // ParallelNewCNF::clausify
+
+/**
+ * Return the number of fresh symbol numbers reserved for the worker
+ * clausifying @b fu
+ *
+ * NewCNF introduces a fresh symbol for a skolemised variable, a named
+ * subformula, or a let or if-then-else term. There are at most as many
+ * of the latter two as there are subformulas and symbol occurrences,
+ * which Formula::weight() counts, so the bound variables are added to
+ * the weight. A number is skipped if the name it makes is taken; if a
+ * worker runs out of numbers due to this, the parent clausifies its shard.
+ */
+unsigned ParallelNewCNF::freshNumberBound(FormulaUnit* fu)
+{
+  CALL("ParallelNewCNF::freshNumberBound");
+
+  Formula* f = fu->formula();
+  Formula::VarList* bound = f->boundVariables();
+  unsigned res = f->weight() + Formula::VarList::length(bound);
+  Formula::VarList::destroy(bound);
+  return res;
+}
+
+/**
+ * Clausify the formulas of @b shard in a forked worker and write the
+ * result into @b out
+ *
+ * The fresh symbols are numbered from @b firstFresh and there must be
+ * at most @b freshCnt of the numbers used. The worker terminates with
+ * a non-zero status if it cannot pass its result to the parent, which
+ * then clausifies the shard itself.
+ *
+ * The file holds the increments of the statistics, the introduced
+ * function and predicate symbols and then the number of clauses of
+ * each formula followed by the clauses.
+ */
+void ParallelNewCNF::runWorker(unsigned shard, int firstFresh, unsigned freshCnt, FILE* out)
+{
+  CALL("ParallelNewCNF::runWorker");
+
+  System::registerForSIGHUPOnParentDeath();
+
+  int resultStatus = 1;
+  try {
+    unsigned sorts = env.sorts->count();
+    unsigned skolemFunctions = env.statistics->skolemFunctions;
+    unsigned formulaNames = env.statistics->formulaNames;
+    env.signature->setNextFreshSymbolNumber(firstFresh);
+
+    NewCNF cnf(_namingThreshold);
+    Stack<Clause*> output(32);
+    Stack<Clause*> clauses;
+    Stack<unsigned> clauseCounts;
+    for (unsigned i = _shardStarts[shard]; i < _shardStarts[shard+1]; i++) {
+      cnf.clausify(_formulas[i], output);
+      clauseCounts.push(output.size());
+      while (output.isNonEmpty()) {
+        clauses.push(output.pop());
+      }
+    }
+
+    bool ok = env.signature->nextFreshSymbolNumber() <= firstFresh+(int)freshCnt &&
+        env.sorts->count() == sorts;
+
+    writeWord(out, env.statistics->skolemFunctions - skolemFunctions);
+    writeWord(out, env.statistics->formulaNames - formulaNames);
+    writeWord(out, env.signature->functions() - _functions);
+    for (unsigned f = _functions; ok && f < env.signature->functions(); f++) {
+      ok = writeSymbol(out, env.signature->getFunction(f), true);
+    }
+    writeWord(out, env.signature->predicates() - _predicates);
+    for (unsigned p = _predicates; ok && p < env.signature->predicates(); p++) {
+      ok = writeSymbol(out, env.signature->getPredicate(p), false);
+    }
+
+    Stack<Clause*>::BottomFirstIterator cit(clauses);
+    Stack<unsigned>::BottomFirstIterator cntIt(clauseCounts);
+    while (ok && cntIt.hasNext()) {
+      unsigned cnt = cntIt.next();
+      writeWord(out, cnt);
+      for (unsigned i = 0; ok && i < cnt; i++) {
+        Clause* cl = cit.next();
+        writeWord(out, cl->length());
+        for (unsigned j = 0; ok && j < cl->length(); j++) {
+          ok = writeLiteral(out, (*cl)[j]);
+        }
+      }
+    }
+
+    if (ok && fflush(out) == 0) {
+      resultStatus = 0;
+    }
+  }
+  catch (...) {
+    // the parent will clausify the shard
+  }
+  System::terminateImmediately(resultStatus);
+} // ParallelNewCNF::runWorker
+
+/**
+ * Read the result of the worker of @b shard from @b in, return false
+ * if a symbol introduced by the worker has a name that is already taken
+ * in this process, in which case nothing is changed
+ */
+bool ParallelNewCNF::readShard(unsigned shard, FILE* in)
+{
+  CALL("ParallelNewCNF::readShard");
+
+  unsigned skolemFunctions = readWord(in);
+  unsigned formulaNames = readWord(in);
+
+  static Stack<SymbolRecord> functions;
+  static Stack<SymbolRecord> predicates;
+  functions.reset();
+  predicates.reset();
+  unsigned cnt = readWord(in);
+  for (unsigned i = 0; i < cnt; i++) {
+    functions.push(SymbolRecord());
+    readSymbol(in, true, functions.top());
+    if (env.signature->functionExists(functions.top().name, functions.top().arity)) {
+      return false;
+    }
+  }
+  cnt = readWord(in);
+  for (unsigned i = 0; i < cnt; i++) {
+    predicates.push(SymbolRecord());
+    readSymbol(in, false, predicates.top());
+    if (env.signature->predicateExists(predicates.top().name, predicates.top().arity)) {
+      return false;
+    }
+  }
+
+  env.statistics->skolemFunctions += skolemFunctions;
+  env.statistics->formulaNames += formulaNames;
+  _functionMap.reset();
+  Stack<SymbolRecord>::BottomFirstIterator fit(functions);
+  while (fit.hasNext()) {
+    _functionMap.push(addSymbol(fit.next(), true));
+  }
+  _predicateMap.reset();
+  Stack<SymbolRecord>::BottomFirstIterator pit(predicates);
+  while (pit.hasNext()) {
+    _predicateMap.push(addSymbol(pit.next(), false));
+  }
+
+  for (unsigned i = _shardStarts[shard]; i < _shardStarts[shard+1]; i++) {
+    FormulaUnit* fu = _formulas[i];
+    unsigned clauseCnt = readWord(in);
+    for (unsigned j = 0; j < clauseCnt; j++) {
+      unsigned length = readWord(in);
+      Inference* inf = new Inference1(Inference::CLAUSIFY, fu);
+      Clause* cl = new(length) Clause(length, fu->inputType(), inf);
+      for (unsigned k = 0; k < length; k++) {
+        (*cl)[k] = readLiteral(in);
+      }
+      _clauses.push(cl);
+    }
+    _clauseEnds.push(_clauses.size());
+  }
+  return true;
+} // ParallelNewCNF::readShard
+
+/**
+ * Clausify the formulas of @b shard in this process
+ */
+void ParallelNewCNF::clausifyShard(unsigned shard)
+{
+  CALL("ParallelNewCNF::clausifyShard");
+
+  NewCNF cnf(_namingThreshold);
+  Stack<Clause*> output(32);
+  for (unsigned i = _shardStarts[shard]; i < _shardStarts[shard+1]; i++) {
+    cnf.clausify(_formulas[i], output);
+    while (output.isNonEmpty()) {
+      _clauses.push(output.pop());
+    }
+    _clauseEnds.push(_clauses.size());
+  }
+}
+
+void ParallelNewCNF::writeWord(FILE* out, unsigned w)
+{
+  CALL("ParallelNewCNF::writeWord");
+
+  if (fwrite(&w, sizeof(w), 1, out) != 1) {
+    SYSTEM_FAIL("Cannot write to a clausification shard file.",errno);
+  }
+}
+
+unsigned ParallelNewCNF::readWord(FILE* in)
+{
+  CALL("ParallelNewCNF::readWord");
+
+  unsigned res;
+  if (fread(&res, sizeof(res), 1, in) != 1) {
+    SYSTEM_FAIL("Cannot read from a clausification shard file.",errno);
+  }
+  return res;
+}
+
+/**
+ * Write symbol @b sym introduced by a worker, return false if the symbol
+ * is not one that the parent can recreate
+ */
+bool ParallelNewCNF::writeSymbol(FILE* out, Signature::Symbol* sym, bool function)
+{
+  CALL("ParallelNewCNF::writeSymbol");
+
+  if (!sym->introduced() || sym->interpreted() || sym->color() != COLOR_TRANSPARENT) {
+    return false;
+  }
+
+  const vstring& name = sym->name();
+  writeWord(out, name.size());
+  if (fwrite(name.c_str(), 1, name.size(), out) != name.size()) {
+    SYSTEM_FAIL("Cannot write to a clausification shard file.",errno);
+  }
+  writeWord(out, sym->arity());
+  writeWord(out, sym->skip());
+
+  OperatorType* type = function ? sym->fnType() : sym->predType();
+  for (unsigned i = 0; i < sym->arity(); i++) {
+    writeWord(out, type->arg(i));
+  }
+  if (function) {
+    writeWord(out, type->result());
+  }
+  return true;
+}
+
+/**
+ * Read into @b rec the symbol written by writeSymbol()
+ */
+void ParallelNewCNF::readSymbol(FILE* in, bool function, SymbolRecord& rec)
+{
+  CALL("ParallelNewCNF::readSymbol");
+
+  rec.name = vstring(readWord(in), ' ');
+  if (fread(&rec.name[0], 1, rec.name.size(), in) != rec.name.size()) {
+    SYSTEM_FAIL("Cannot read from a clausification shard file.",errno);
+  }
+  rec.arity = readWord(in);
+  rec.skip = readWord(in);
+
+  rec.argSorts.reset();
+  for (unsigned i = 0; i < rec.arity; i++) {
+    rec.argSorts.push(readWord(in));
+  }
+  if (function) {
+    rec.resultSort = readWord(in);
+  }
+}
+
+/**
+ * Add to the signature the symbol read by readSymbol() and return its number
+ * @pre No symbol of the same name and arity is in the signature
+ */
+unsigned ParallelNewCNF::addSymbol(const SymbolRecord& rec, bool function)
+{
+  CALL("ParallelNewCNF::addSymbol");
+
+  bool added;
+  unsigned res;
+  Signature::Symbol* sym;
+  if (function) {
+    res = env.signature->addFunction(rec.name, rec.arity, added);
+    ASS(added);
+    sym = env.signature->getFunction(res);
+    sym->setType(OperatorType::getFunctionType(rec.arity, rec.argSorts.begin(), rec.resultSort));
+  }
+  else {
+    res = env.signature->addPredicate(rec.name, rec.arity, added);
+    ASS(added);
+    sym = env.signature->getPredicate(res);
+    sym->setType(OperatorType::getPredicateType(rec.arity, rec.argSorts.begin()));
+  }
+  sym->markIntroduced();
+  if (rec.skip) {
+    sym->markSkip();
+  }
+  return res;
+}
+
+/**
+ * Write term @b t in prefix order, a variable as its number shifted
+ * left with the lowest bit set and a term as its functor shifted left.
+ * Return false if the term contains a special term or variable.
+ */
+bool ParallelNewCNF::writeTerm(FILE* out, TermList t)
+{
+  CALL("ParallelNewCNF::writeTerm");
+
+  if (t.isOrdinaryVar()) {
+    writeWord(out, (t.var() << 1) | 1);
+    return true;
+  }
+  if (t.isVar() || t.term()->isSpecial()) {
+    return false;
+  }
+
+  Term* trm = t.term();
+  writeWord(out, trm->functor() << 1);
+  for (unsigned i = 0; i < trm->arity(); i++) {
+    if (!writeTerm(out, *trm->nthArgument(i))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+TermList ParallelNewCNF::readTerm(FILE* in)
+{
+  CALL("ParallelNewCNF::readTerm");
+
+  unsigned w = readWord(in);
+  if (w & 1) {
+    return TermList(w >> 1, false);
+  }
+  unsigned fn = w >> 1;
+  if (fn >= _functions) {
+    fn = _functionMap[fn - _functions];
+  }
+  unsigned arity = env.signature->functionArity(fn);
+  DArray<TermList> args(arity);
+  for (unsigned i = 0; i < arity; i++) {
+    args[i] = readTerm(in);
+  }
+  return TermList(Term::create(fn, arity, args.begin()));
+}
+
+/**
+ * Write literal @b lit as its predicate, polarity, the argument sort
+ * if it is an equality, and its arguments
+ */
+bool ParallelNewCNF::writeLiteral(FILE* out, Literal* lit)
+{
+  CALL("ParallelNewCNF::writeLiteral");
+
+  writeWord(out, lit->functor());
+  writeWord(out, lit->polarity());
+  if (lit->isEquality()) {
+    writeWord(out, SortHelper::getEqualityArgumentSort(lit));
+  }
+  for (unsigned i = 0; i < lit->arity(); i++) {
+    if (!writeTerm(out, *lit->nthArgument(i))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+Literal* ParallelNewCNF::readLiteral(FILE* in)
+{
+  CALL("ParallelNewCNF::readLiteral");
+
+  unsigned pred = readWord(in);
+  bool polarity = readWord(in);
+  if (!pred) {
+    unsigned sort = readWord(in);
+    TermList arg1 = readTerm(in);
+    TermList arg2 = readTerm(in);
+    return Literal::createEquality(polarity, arg1, arg2, sort);
+  }
+
+  if (pred >= _predicates) {
+    pred = _predicateMap[pred - _predicates];
+  }
+  unsigned arity = env.signature->predicateArity(pred);
+  DArray<TermList> args(arity);
+  for (unsigned i = 0; i < arity; i++) {
+    args[i] = readTerm(in);
+  }
+  return Literal::create(pred, arity, polarity, false, args.begin());
+}
+
+}
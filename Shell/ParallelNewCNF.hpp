@@ -0,0 +1,115 @@
+/*
+ * File ParallelNewCNF.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file ParallelNewCNF.hpp
+ * Defines class ParallelNewCNF running NewCNF in forked worker processes.
+ */
+
+#ifndef __ParallelNewCNF__
+#define __ParallelNewCNF__
+
+#include <cstdio>
+
+#include "Forwards.hpp"
+
+#include "Lib/DArray.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Kernel/Signature.hpp"
+#include "Kernel/Term.hpp"
+
+namespace Shell {
+
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * Clausification of the formulas of a problem by NewCNF, sharded across
+ * forked worker processes.
+ *
+ * The formulas are split into contiguous shards, one per worker. Each
+ * worker names its fresh symbols from its own block of numbers reserved
+ * in the signature, clausifies its shard and writes the new symbols and
+ * the clauses into a temporary file. The parent reads the shards back in
+ * order, so the clauses come out in the order the sequential loop of
+ * Preprocess::newCnf would produce. A shard whose worker did not succeed,
+ * or whose symbols cannot be added to the signature of the parent under
+ * their names, is clausified by the parent itself.
+ */
+class ParallelNewCNF
+{
+public:
+  ParallelNewCNF(unsigned namingThreshold, unsigned workers)
+  : _namingThreshold(namingThreshold), _workers(workers) {}
+
+  bool clausify(UnitList*& units);
+
+private:
+  /** A symbol introduced by a worker, as read from its shard file */
+  struct SymbolRecord
+  {
+    vstring name;
+    unsigned arity;
+    bool skip;
+    Stack<unsigned> argSorts;
+    /** Sort of the result, only for function symbols */
+    unsigned resultSort;
+  };
+
+  static bool canShard();
+  static unsigned freshNumberBound(FormulaUnit* fu);
+
+  void runWorker(unsigned shard, int firstFresh, unsigned freshCnt, FILE* out) __attribute__((noreturn));
+  bool readShard(unsigned shard, FILE* in);
+  void clausifyShard(unsigned shard);
+
+  static void writeWord(FILE* out, unsigned w);
+  static unsigned readWord(FILE* in);
+  static bool writeSymbol(FILE* out, Signature::Symbol* sym, bool function);
+  static void readSymbol(FILE* in, bool function, SymbolRecord& rec);
+  static unsigned addSymbol(const SymbolRecord& rec, bool function);
+  static bool writeTerm(FILE* out, TermList t);
+  TermList readTerm(FILE* in);
+  static bool writeLiteral(FILE* out, Literal* lit);
+  Literal* readLiteral(FILE* in);
+
+  unsigned _namingThreshold;
+  unsigned _workers;
+
+  /** Formulas to clausify, in the order of the unit list */
+  Stack<FormulaUnit*> _formulas;
+  /** Index of the first formula of each shard, with the end of the last one appended */
+  DArray<unsigned> _shardStarts;
+  /** Number of function symbols at the time the workers were forked */
+  unsigned _functions;
+  /** Number of predicate symbols at the time the workers were forked */
+  unsigned _predicates;
+  /** Parent numbers of the function symbols introduced by the shard being read */
+  Stack<unsigned> _functionMap;
+  /** Parent numbers of the predicate symbols introduced by the shard being read */
+  Stack<unsigned> _predicateMap;
+
+  /** Clauses of all formulas, grouped by formula in the order of @b _formulas */
+  Stack<Clause*> _clauses;
+  /** Index into @b _clauses after the last clause of each formula */
+  Stack<unsigned> _clauseEnds;
+};
+
+}
+
+#endif // __ParallelNewCNF__
@@ -26,6 +26,7 @@
 #include "Debug/Tracer.hpp"
 
 #include "Lib/ScopedLet.hpp"
+#include "Lib/TimeCounter.hpp"
 
 #include "Kernel/Unit.hpp"
 #include "Kernel/Clause.hpp"
@@ -46,6 +47,7 @@
 #include "Normalisation.hpp"
 #include "NNF.hpp"
 #include "Options.hpp"
+#include "ParallelNewCNF.hpp"
 #include "PredicateDefinition.hpp"
 #include "Preprocess.hpp"
 #include "Property.hpp"
@@ -549,6 +551,7 @@ void Preprocess::newCnf(Problem& prb)
   CALL("Preprocess::newCnf");
 
   env.statistics->phase=Statistics::NEW_CNF;
+  TimeCounter tc(TC_CLAUSIFICATION);
 
   // TODO: this is an ugly copy-paste of "Preprocess::clausify"
 
@@ -557,6 +560,12 @@ void Preprocess::newCnf(Problem& prb)
 
   bool modified = false;
 
+  if (env.options->newCNFWorkers() > 1) {
+    // replaces the formulas by their clauses, the loop below then only looks for the empty clause
+    ParallelNewCNF pcnf(env.options->naming(), env.options->newCNFWorkers());
+    modified = pcnf.clausify(prb.units());
+  }
+
   UnitList::DelIterator us(prb.units());
   NewCNF cnf(env.options->naming());
   Stack<Clause*> clauses(32);
@@ -670,6 +679,7 @@ void Preprocess::clausify(Problem& prb)
   CALL("Preprocess::clausify");
 
   env.statistics->phase=Statistics::CLAUSIFICATION;
+  TimeCounter tc(TC_CLAUSIFICATION);
 
   //we check if we haven't discovered an empty clause during preprocessing
   Unit* emptyClause = 0;
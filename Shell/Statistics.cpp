@@ -24,6 +24,7 @@
  */
 
 #include <iostream>
+#include <fstream>
 
 #include "Debug/RuntimeStatistics.hpp"
 
@@ -89,10 +90,13 @@ Statistics::Statistics()
     trivialInequalities(0),
     forwardSubsumptionResolution(0),
     backwardSubsumptionResolution(0),
+    subsumptionFeatureRejections(0),
     forwardDemodulations(0),
     forwardDemodulationsToEqTaut(0),
+    forwardDemodulationNormalFormHits(0),
     backwardDemodulations(0),
     backwardDemodulationsToEqTaut(0),
+    backwardSimplificationBatches(0),
     forwardLiteralRewrites(0),
     condensations(0),
     globalSubsumption(0),
@@ -110,12 +114,29 @@ Statistics::Statistics()
     taInjectivitySimplifications(0),
     taNegativeInjectivitySimplifications(0),
     taAcyclicityGeneratedDisequalities(0),
+    substTreeNodes(0),
+    maxSubstTreeNodes(0),
+    substTreeArrayMemory(0),
+    maxSubstTreeArrayMemory(0),
+    substTreeRetrievals(0),
+    substTreeNodesVisited(0),
+    substTreeGroundRetrievals(0),
     generatedClauses(0),
     passiveClauses(0),
     activeClauses(0),
     extensionalityClauses(0),
     discardedNonRedundantClauses(0),
+    spilledPassiveClauses(0),
+    reloadedPassiveClauses(0),
+    ageQueueSelections(0),
+    weightQueueSelections(0),
+    goalQueueSelections(0),
+    theoryQueueSelections(0),
+    splitQueueSelections(0),
+    symbolQueueSelections(0),
     inferencesBlockedForOrderingAftercheck(0),
+    orderingCacheHits(0),
+    orderingCacheMisses(0),
     smtReturnedUnknown(false),
     inferencesSkippedDueToColors(0),
     finalPassiveClauses(0),
@@ -139,6 +160,11 @@ Statistics::Statistics()
     satTWLClauseCount(0),
     satTWLVariablesCount(0),
     satTWLSATCalls(0),
+    satConflicts(0),
+    satPropagations(0),
+    satTWLInprocessings(0),
+    satTWLSubsumedLearnts(0),
+    satTWLRemovedLearntLiterals(0),
 
     instGenGeneratedClauses(0),
     instGenRedundantClauses(0),
@@ -146,17 +172,91 @@ Statistics::Statistics()
     instGenIterations(0),
 
     maxBFNTModelSize(0),
+    fmbLazyInstances(0),
+    fmbLazyRefinements(0),
+    fmbIncrementalRounds(0),
 
     satPureVarsEliminated(0),
     terminationReason(UNKNOWN),
     refutation(0),
     saturatedSet(0),
-    phase(INITIALIZATION)
+    phase(INITIALIZATION),
+    firstActivationTime(-1)
 {
+  for (unsigned i=0; i<=UNKNOWN_PHASE; i++) {
+    phaseMilliseconds[i]=0;
+    phasePeakMemory[i]=0;
+  }
 } // Statistics::Statistics
 
+/**
+ * Attribute one millisecond and the current memory usage to the current phase.
+ *
+ * Called from the timer signal handler, so it must not allocate.
+ */
+void Statistics::samplePhase()
+{
+  phaseMilliseconds[phase]++;
+  size_t mem=Allocator::getUsedMemory();
+  if (mem>phasePeakMemory[phase]) {
+    phasePeakMemory[phase]=mem;
+  }
+}
+
+/**
+ * Output the per-phase time and memory profile as a JSON object.
+ */
+void Statistics::printStartupProfile(ostream& out)
+{
+  size_t peak=0;
+  for (unsigned i=0; i<=UNKNOWN_PHASE; i++) {
+    peak=max(peak,phasePeakMemory[i]);
+  }
+
+  out << "{\n";
+  out << "  \"problem\": \"";
+  vstring name=env.options->problemName();
+  for (unsigned i=0; i<name.size(); i++) {
+    if (name[i]=='"' || name[i]=='\\') {
+      out << '\\';
+    }
+    out << name[i];
+  }
+  out << "\",\n";
+  out << "  \"elapsed_ms\": " << env.timer->elapsedMilliseconds() << ",\n";
+  out << "  \"peak_memory_kb\": " << peak/1024 << ",\n";
+  out << "  \"first_activation_ms\": ";
+  if (firstActivationTime==-1) {
+    out << "null";
+  }
+  else {
+    out << firstActivationTime;
+  }
+  out << ",\n";
+  out << "  \"phases\": [";
+  bool first=true;
+  for (unsigned i=0; i<=UNKNOWN_PHASE; i++) {
+    if (!phaseMilliseconds[i] && !phasePeakMemory[i]) {
+      continue;
+    }
+    out << (first ? "\n" : ",\n");
+    first=false;
+    out << "    { \"phase\": \"" << phaseToString(static_cast<ExecutionPhase>(i)) << "\", "
+        << "\"ms\": " << phaseMilliseconds[i] << ", "
+        << "\"peak_memory_kb\": " << phasePeakMemory[i]/1024 << " }";
+  }
+  out << "\n  ]\n}\n";
+}
+
 void Statistics::print(ostream& out)
 {
+  if (env.options->startupProfile()!="off") {
+    BYPASSING_ALLOCATOR;
+
+    ofstream profileOut(env.options->startupProfile().c_str());
+    printStartupProfile(profileOut);
+  }
+
   if (env.options->statistics()==Options::Statistics::NONE) {
     return;
   }
@@ -249,7 +349,7 @@ void Statistics::print(ostream& out)
 
   HEADING("Saturation",activeClauses+passiveClauses+extensionalityClauses+
       generatedClauses+finalActiveClauses+finalPassiveClauses+finalExtensionalityClauses+
-      discardedNonRedundantClauses+inferencesSkippedDueToColors+inferencesBlockedForOrderingAftercheck);
+      discardedNonRedundantClauses+spilledPassiveClauses+inferencesSkippedDueToColors+inferencesBlockedForOrderingAftercheck);
   COND_OUT("Initial clauses", initialClauses);
   COND_OUT("Generated clauses", generatedClauses);
   COND_OUT("Active clauses", activeClauses);
@@ -260,8 +360,18 @@ void Statistics::print(ostream& out)
   COND_OUT("Final passive clauses", finalPassiveClauses);
   COND_OUT("Final extensionality clauses", finalExtensionalityClauses);
   COND_OUT("Discarded non-redundant clauses", discardedNonRedundantClauses);
+  COND_OUT("Spilled passive clauses", spilledPassiveClauses);
+  COND_OUT("Reloaded passive clauses", reloadedPassiveClauses);
+  COND_OUT("Age queue selections", ageQueueSelections);
+  COND_OUT("Weight queue selections", weightQueueSelections);
+  COND_OUT("Goal queue selections", goalQueueSelections);
+  COND_OUT("Theory queue selections", theoryQueueSelections);
+  COND_OUT("Split queue selections", splitQueueSelections);
+  COND_OUT("Symbol queue selections", symbolQueueSelections);
   COND_OUT("Inferences skipped due to colors", inferencesSkippedDueToColors);
   COND_OUT("Inferences blocked due to ordering aftercheck", inferencesBlockedForOrderingAftercheck);
+  COND_OUT("Ordering cache hits", orderingCacheHits);
+  COND_OUT("Ordering cache misses", orderingCacheMisses);
   SEPARATOR;
 
 
@@ -274,7 +384,9 @@ void Statistics::print(ostream& out)
   COND_OUT("Fw subsumption resolutions", forwardSubsumptionResolution);
   COND_OUT("Bw subsumption resolutions", backwardSubsumptionResolution);
   COND_OUT("Fw demodulations", forwardDemodulations);
+  COND_OUT("Fw demodulation normal form hits", forwardDemodulationNormalFormHits);
   COND_OUT("Bw demodulations", backwardDemodulations);
+  COND_OUT("Bw simplification batches", backwardSimplificationBatches);
   COND_OUT("Fw literal rewrites", forwardLiteralRewrites);
   COND_OUT("Inner rewrites", innerRewrites);
   COND_OUT("Condensations", condensations);
@@ -291,6 +403,7 @@ void Statistics::print(ostream& out)
   COND_OUT("Deep equational tautologies", deepEquationalTautologies);
   COND_OUT("Forward subsumptions", forwardSubsumed);
   COND_OUT("Backward subsumptions", backwardSubsumed);
+  COND_OUT("Subsumption candidates rejected by features", subsumptionFeatureRejections);
   COND_OUT("Fw demodulations to eq. taut.", forwardDemodulationsToEqTaut);
   COND_OUT("Bw demodulations to eq. taut.", backwardDemodulationsToEqTaut);
   COND_OUT("Inner rewrites to eq. taut.", innerRewritesToEqTaut);
@@ -322,6 +435,15 @@ void Statistics::print(ostream& out)
   COND_OUT("TheoryInstSimpLostSolution",theoryInstSimpLostSolution);
   SEPARATOR;
 
+  HEADING("Indexing",maxSubstTreeNodes+substTreeRetrievals+substTreeGroundRetrievals);
+  COND_OUT("Max substitution tree nodes", maxSubstTreeNodes);
+  COND_OUT("Max substitution tree array memory [KB]", maxSubstTreeArrayMemory/1024);
+  COND_OUT("Substitution tree retrievals", substTreeRetrievals);
+  COND_OUT("Substitution tree nodes visited", substTreeNodesVisited);
+  COND_OUT("Avg. nodes visited per retrieval", substTreeRetrievals ? substTreeNodesVisited/substTreeRetrievals : 0);
+  COND_OUT("Substitution tree ground retrievals", substTreeGroundRetrievals);
+  SEPARATOR;
+
   HEADING("Term algebra simplifications",taDistinctnessSimplifications+
       taDistinctnessTautologyDeletions+taInjectivitySimplifications+
       taAcyclicityGeneratedDisequalities+taNegativeInjectivitySimplifications);
@@ -350,15 +472,18 @@ void Statistics::print(ostream& out)
   SEPARATOR;
 
   //TODO record statistics for FMB
-  HEADING("Model Building",maxBFNTModelSize);
+  HEADING("Model Building",maxBFNTModelSize+fmbLazyInstances+fmbIncrementalRounds);
   COND_OUT("Max BFNT model size", maxBFNTModelSize);
+  COND_OUT("Lazy FMB instances", fmbLazyInstances);
+  COND_OUT("Lazy FMB refinements", fmbLazyRefinements);
+  COND_OUT("Incremental FMB rounds", fmbIncrementalRounds);
   SEPARATOR;
 
 
   //TODO record statistics for MiniSAT
   HEADING("SAT Solver Statistics",satTWLClauseCount+satTWLVariablesCount+
         satTWLSATCalls+satClauses+unitSatClauses+binarySatClauses+
-        learntSatClauses+learntSatLiterals+satPureVarsEliminated);
+        learntSatClauses+learntSatLiterals+satConflicts+satTWLInprocessings+satPureVarsEliminated);
   COND_OUT("SAT solver clauses", satClauses);
   COND_OUT("SAT solver unit clauses", unitSatClauses);
   COND_OUT("SAT solver binary clauses", binarySatClauses);
@@ -367,6 +492,11 @@ void Statistics::print(ostream& out)
   COND_OUT("TWLsolver clauses", satTWLClauseCount);
   COND_OUT("TWLsolver variables", satTWLVariablesCount);
   COND_OUT("TWLsolver calls for satisfiability", satTWLSATCalls);
+  COND_OUT("SAT solver conflicts", satConflicts);
+  COND_OUT("SAT solver propagations", satPropagations);
+  COND_OUT("TWLsolver inprocessing rounds", satTWLInprocessings);
+  COND_OUT("TWLsolver learnt clauses subsumed", satTWLSubsumedLearnts);
+  COND_OUT("TWLsolver learnt literals removed by inprocessing", satTWLRemovedLearntLiterals);
   COND_OUT("Pure propositional variables eliminated by SAT solver", satPureVarsEliminated);
   SEPARATOR;
 
@@ -143,14 +143,20 @@ public:
   unsigned forwardSubsumptionResolution;
   /** number of backward subsumption resolutions */
   unsigned backwardSubsumptionResolution;
+  /** number of subsumption candidates rejected by clause features */
+  unsigned subsumptionFeatureRejections;
   /** number of forward demodulations */
   unsigned forwardDemodulations;
   /** number of forward demodulations into equational tautologies */
   unsigned forwardDemodulationsToEqTaut;
+  /** number of terms skipped by forward demodulation as known normal forms */
+  unsigned forwardDemodulationNormalFormHits;
   /** number of backward demodulations */
   unsigned backwardDemodulations;
   /** number of backward demodulations into equational tautologies */
   unsigned backwardDemodulationsToEqTaut;
+  /** number of batches of backward simplification premises processed */
+  unsigned backwardSimplificationBatches;
   /** number of forward literal rewrites */
   unsigned forwardLiteralRewrites;
   /** number of condensations */
@@ -185,6 +191,22 @@ public:
   unsigned taNegativeInjectivitySimplifications;
   unsigned taAcyclicityGeneratedDisequalities;
 
+  // Indexing
+  /** number of substitution tree nodes currently allocated */
+  unsigned substTreeNodes;
+  /** maximal number of substitution tree nodes allocated at once */
+  unsigned maxSubstTreeNodes;
+  /** memory currently taken by arrays of substitution tree children and leaf entries */
+  size_t substTreeArrayMemory;
+  /** maximal memory taken by arrays of substitution tree children and leaf entries */
+  size_t maxSubstTreeArrayMemory;
+  /** number of retrievals from substitution trees */
+  unsigned long substTreeRetrievals;
+  /** number of substitution tree nodes visited by the retrievals */
+  unsigned long substTreeNodesVisited;
+  /** number of substitution tree retrievals answered from the ground entries */
+  unsigned long substTreeGroundRetrievals;
+
   // Saturation
   /** all clauses ever occurring in the unprocessed queue */
   unsigned generatedClauses;
@@ -196,9 +218,25 @@ public:
   unsigned extensionalityClauses;
 
   unsigned discardedNonRedundantClauses;
+  /** passive clauses set aside on an LRS limit update instead of being discarded */
+  unsigned spilledPassiveClauses;
+  /** set aside passive clauses that were added again */
+  unsigned reloadedPassiveClauses;
+  /** clauses selected from the respective queues of the multi-queue passive container */
+  unsigned ageQueueSelections;
+  unsigned weightQueueSelections;
+  unsigned goalQueueSelections;
+  unsigned theoryQueueSelections;
+  unsigned splitQueueSelections;
+  unsigned symbolQueueSelections;
 
   unsigned inferencesBlockedForOrderingAftercheck;
 
+  /** number of term ordering comparisons answered from the cache */
+  unsigned long orderingCacheHits;
+  /** number of cacheable term ordering comparisons that were not in the cache */
+  unsigned long orderingCacheMisses;
+
   bool smtReturnedUnknown;
 
   unsigned inferencesSkippedDueToColors;
@@ -234,6 +272,16 @@ public:
   unsigned satTWLClauseCount;
   unsigned satTWLVariablesCount;
   unsigned satTWLSATCalls;
+  /** Number of conflicts encountered by the SAT solvers */
+  unsigned long satConflicts;
+  /** Number of literals propagated by the SAT solvers */
+  unsigned long satPropagations;
+  /** Number of inprocessing rounds of the TWL SAT solver */
+  unsigned satTWLInprocessings;
+  /** Number of learnt clauses removed by TWL inprocessing subsumption */
+  unsigned satTWLSubsumedLearnts;
+  /** Number of literals removed from learnt clauses by TWL inprocessing */
+  unsigned satTWLRemovedLearntLiterals;
 
   unsigned instGenGeneratedClauses;
   unsigned instGenRedundantClauses;
@@ -241,6 +289,12 @@ public:
   unsigned instGenIterations;
 
   unsigned maxBFNTModelSize;
+  /** Number of FMB instances added because the SAT model violated them */
+  unsigned fmbLazyInstances;
+  /** Number of SAT calls refining an FMB model with lazy instances */
+  unsigned fmbLazyRefinements;
+  /** Number of FMB size changes that kept the SAT solver */
+  unsigned fmbIncrementalRounds;
 
   /** Number of pure variables eliminated by SAT solver */
   unsigned satPureVarsEliminated;
@@ -407,6 +461,16 @@ public:
 
   ExecutionPhase phase;
 
+  /** milliseconds spent in each execution phase, sampled by the timer */
+  unsigned phaseMilliseconds[UNKNOWN_PHASE+1];
+  /** peak memory used by the allocator in each execution phase, sampled by the timer */
+  size_t phasePeakMemory[UNKNOWN_PHASE+1];
+  /** elapsed milliseconds at the first activation of a clause, or -1 */
+  int firstActivationTime;
+
+  void samplePhase();
+  void printStartupProfile(ostream& out);
+
 private:
   static const char* phaseToString(ExecutionPhase p);
 }; // class Statistics
@@ -151,28 +151,41 @@ TermList SymbolDefinitionInlining::process(TermList ts) {
     }
   }
 
+  TermList result;
+  if (term->shared() && _sharedTermResults.find(term, result)) {
+    return result;
+  }
+
   Term::Iterator terms(term);
 
   if (!_isPredicate && (term->functor() == _symbol)) {
-    return substitute(terms);
-  }
-
-  bool substituted = false;
-  Stack<TermList> args;
-  while (terms.hasNext()) {
-    TermList argument = terms.next();
-    TermList processedArgument = process(argument);
-    if (argument != processedArgument) {
-      substituted = true;
+    result = substitute(terms);
+  } else {
+    bool substituted = false;
+    Stack<TermList> args;
+    while (terms.hasNext()) {
+      TermList argument = terms.next();
+      TermList processedArgument = process(argument);
+      if (argument != processedArgument) {
+        substituted = true;
+      }
+      args.push(processedArgument);
     }
-    args.push(processedArgument);
+
+    result = substituted ? TermList(Term::create(term, args.begin())) : ts;
   }
 
-  if (!substituted) {
-    return ts;
+  /**
+   * A result can be reused for other occurrences of the term unless it
+   * contains an inlined copy of the binding with renamed bound variables,
+   * as every copy of such a binding needs its own fresh variables. A shared
+   * binding has no bound variables.
+   */
+  if (term->shared() && (result == ts || !_binding.isTerm() || _binding.term()->shared())) {
+    _sharedTermResults.insert(term, result);
   }
 
-  return TermList(Term::create(term, args.begin()));
+  return result;
 }
 
 bool SymbolDefinitionInlining::mirroredTuple(Term* tuple, TermList &tupleConstant) {
@@ -23,6 +23,7 @@
 
 #include "Kernel/Signature.hpp"
 #include "Kernel/SubstHelper.hpp"
+#include "Lib/DHMap.hpp"
 #include "Lib/Environment.hpp"
 #include "Lib/Set.hpp"
 
@@ -63,6 +64,12 @@ class SymbolDefinitionInlining {
     void collectBoundVariables(Formula*);
 
     Set<Formula*> _superformulas;
+
+    /**
+     * Results of processing of shared terms. Shared terms are often DAGs, so
+     * without remembering the results they would be processed as trees.
+     */
+    DHMap<Term*,TermList> _sharedTermResults;
 };
 
 #endif // __SymbolDefinitionInlining__
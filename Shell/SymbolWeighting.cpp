@@ -0,0 +1,180 @@
+
+/*
+ * File SymbolWeighting.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file SymbolWeighting.cpp
+ * Implements class SymbolWeighting.
+ */
+
+#include "Lib/BitUtils.hpp"
+#include "Lib/Environment.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Problem.hpp"
+#include "Kernel/Signature.hpp"
+
+#include "Indexing/TermSharing.hpp"
+
+#include "SineUtils.hpp"
+#include "SymCounter.hpp"
+
+#include "SymbolWeighting.hpp"
+
+namespace Shell
+{
+
+const unsigned SymbolWeighting::GOAL_DISTANCE_LIMIT;
+
+void SymbolWeighting::apply(Problem& prb)
+{
+  CALL("SymbolWeighting::apply");
+
+  switch(_opt.symbolWeighting()) {
+  case Options::SymbolWeighting::OFF:
+    return;
+  case Options::SymbolWeighting::FREQUENCY:
+    weightByFrequency(prb);
+    break;
+  case Options::SymbolWeighting::GOAL:
+    weightByGoalDistance(prb);
+    break;
+  }
+  env.sharing->setSymbolWeights(_functionWeights, _predicateWeights);
+}
+
+/**
+ * Give each symbol the weight 1+log2(m/n), where n is the number of its
+ * occurrences in the clauses of @b prb and m the number of occurrences
+ * of the most frequent symbol. Rare symbols are thus heavier.
+ */
+void SymbolWeighting::weightByFrequency(Problem& prb)
+{
+  CALL("SymbolWeighting::weightByFrequency");
+
+  SymCounter counter(*env.signature);
+  ClauseIterator cit=prb.clauseIterator();
+  while (cit.hasNext()) {
+    counter.count(cit.next(), 1);
+  }
+
+  unsigned funs=env.signature->functions();
+  unsigned preds=env.signature->predicates();
+  _functionWeights.init(funs, 0);
+  _predicateWeights.init(preds, 0);
+
+  //first store the occurrence counts, then turn them into weights
+  unsigned maxOcc=1;
+  for (unsigned f=0;f<funs;f++) {
+    _functionWeights[f]=counter.getFun(f).occ();
+    maxOcc=max(maxOcc, _functionWeights[f]);
+  }
+  for (unsigned p=0;p<preds;p++) {
+    SymCounter::Pred& pred=counter.getPred(p);
+    _predicateWeights[p]=pred.pocc()+pred.nocc()+pred.docc();
+    maxOcc=max(maxOcc, _predicateWeights[p]);
+  }
+
+  for (unsigned f=0;f<funs;f++) {
+    _functionWeights[f]=1+BitUtils::log2(maxOcc/max(_functionWeights[f],1u));
+  }
+  for (unsigned p=0;p<preds;p++) {
+    _predicateWeights[p]=1+BitUtils::log2(maxOcc/max(_predicateWeights[p],1u));
+  }
+}
+
+/**
+ * Give each symbol the weight 1+d, where d is its distance from the goal:
+ * symbols of goal clauses have distance 0 and the symbols of a clause
+ * containing a symbol of distance d have distance at most d+1, as in the
+ * SInE selection without the generality condition. Symbols at distance
+ * GOAL_DISTANCE_LIMIT or more, or not connected to the goal at all, share
+ * the greatest weight.
+ *
+ * If there are no goal clauses, all symbols get weight 1.
+ */
+void SymbolWeighting::weightByGoalDistance(Problem& prb)
+{
+  CALL("SymbolWeighting::weightByGoalDistance");
+
+  typedef SineSymbolExtractor::SymId SymId;
+
+  SineSymbolExtractor symExtr;
+  DArray<unsigned> dist;
+  dist.init(symExtr.getSymIdBound(), GOAL_DISTANCE_LIMIT);
+
+  bool haveGoal=false;
+  Stack<Clause*> remaining;
+  ClauseIterator cit=prb.clauseIterator();
+  while (cit.hasNext()) {
+    Clause* cl=cit.next();
+    if (!cl->isGoal()) {
+      remaining.push(cl);
+      continue;
+    }
+    haveGoal=true;
+    SineSymbolExtractor::SymIdIterator sit=symExtr.extractSymIds(cl);
+    while (sit.hasNext()) {
+      dist[sit.next()]=0;
+    }
+  }
+  if (!haveGoal) {
+    return;
+  }
+
+  Stack<SymId> syms;
+  Stack<Clause*> untriggered;
+  for (unsigned d=0;d+1<GOAL_DISTANCE_LIMIT && remaining.isNonEmpty();d++) {
+    Stack<Clause*>::Iterator rit(remaining);
+    while (rit.hasNext()) {
+      Clause* cl=rit.next();
+      syms.reset();
+      syms.loadFromIterator(symExtr.extractSymIds(cl));
+
+      bool triggered=false;
+      Stack<SymId>::Iterator sit(syms);
+      while (sit.hasNext() && !triggered) {
+        triggered=dist[sit.next()]==d;
+      }
+      if (!triggered) {
+        untriggered.push(cl);
+        continue;
+      }
+      Stack<SymId>::Iterator sit2(syms);
+      while (sit2.hasNext()) {
+        SymId s=sit2.next();
+        dist[s]=min(dist[s], d+1);
+      }
+    }
+    swap(remaining, untriggered);
+    untriggered.reset();
+  }
+
+  unsigned funs=env.signature->functions();
+  unsigned preds=env.signature->predicates();
+  _functionWeights.init(funs, 0);
+  _predicateWeights.init(preds, 0);
+  for (unsigned f=0;f<funs;f++) {
+    _functionWeights[f]=1+dist[f*2+1];
+  }
+  for (unsigned p=0;p<preds;p++) {
+    _predicateWeights[p]=1+dist[p*2];
+  }
+}
+
+}
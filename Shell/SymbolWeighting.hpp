@@ -0,0 +1,65 @@
+
+/*
+ * File SymbolWeighting.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file SymbolWeighting.hpp
+ * Defines class SymbolWeighting.
+ */
+
+#ifndef __SymbolWeighting__
+#define __SymbolWeighting__
+
+#include "Forwards.hpp"
+
+#include "Lib/DArray.hpp"
+
+#include "Options.hpp"
+
+namespace Shell {
+
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * Computes the table of symbol weights selected by Options::symbolWeighting()
+ * from the preprocessed problem and sets it in the term sharing structure,
+ * see TermSharing::setSymbolWeights()
+ */
+class SymbolWeighting
+{
+public:
+  SymbolWeighting(const Options& opt) : _opt(opt) {}
+
+  void apply(Problem& prb);
+
+private:
+  void weightByFrequency(Problem& prb);
+  void weightByGoalDistance(Problem& prb);
+
+  /** Distance from the goal beyond which symbols are not distinguished, see weightByGoalDistance() */
+  static const unsigned GOAL_DISTANCE_LIMIT = 4;
+
+  const Options& _opt;
+
+  DArray<unsigned> _functionWeights;
+  DArray<unsigned> _predicateWeights;
+};
+
+}
+
+#endif // __SymbolWeighting__
@@ -155,3 +155,38 @@ TEST_FUN(dheapIncreasing)
   }
   ASS_EQ(resCnt,cnt);
 }
+
+TEST_FUN(dheapRemoving)
+{
+  int cnt=100;
+  int vals[100];
+
+  IndirectComparator myCmp(vals);
+  DynamicHeap<int, IndirectComparator, ArrayMap<unsigned> > dh(myCmp);
+  dh.elMap().expand(cnt);
+
+  for(int i=0;i<cnt;i++) {
+    int idx = (i*3)%100;
+    vals[idx] = (idx*37)%101;
+    dh.insert(idx);
+  }
+
+  for(int i=0;i<cnt;i+=3) {
+    int idx = (i*7)%100;
+    ASS(dh.contains(idx));
+    dh.remove(idx);
+    ASS(!dh.contains(idx));
+  }
+
+  int resCnt=0;
+  int prev=INT_MIN;
+  while(!dh.isEmpty()) {
+    int cur=dh.pop();
+    if(prev!=INT_MIN) {
+      ASS_G(vals[cur],vals[prev]);
+    }
+    prev=cur;
+    resCnt++;
+  }
+  ASS_EQ(resCnt,cnt-34);
+}
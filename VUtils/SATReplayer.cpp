@@ -21,14 +21,13 @@
  * Implements class SATReplayer.
  */
 
-#include <fstream>
-
 #include "Lib/Environment.hpp"
+#include "Lib/Timer.hpp"
 
+#include "SAT/MinisatInterfacing.hpp"
+#include "SAT/RecordingSolver.hpp"
 #include "SAT/TWLSolver.hpp"
 
-#include "Test/RecordingSatSolver.hpp"
-
 #include "SATReplayer.hpp"
 
 namespace VUtils
@@ -37,23 +36,38 @@ namespace VUtils
 using namespace Lib;
 using namespace SAT;
 
+/**
+ * Replay a SAT trace written with the sat_trace option on the TWL
+ * solver or on minisat and print the time it took.
+ */
 int SATReplayer::perform(int argc, char** argv)
 {
   CALL("SATReplayer::perform");
 
-  if(argc!=4) {
+  if(argc<3 || argc>4 || (argc==4 && vstring(argv[3])!="vampire" && vstring(argv[3])!="minisat")) {
     cerr << "invalid command line"<<endl<<
 	    "Usage:"<<endl<<
-	    argv[0]<<" "<<argv[1]<<" <prefix> <file name>"<<endl;
+	    argv[0]<<" "<<argv[1]<<" <trace file> [vampire|minisat]"<<endl;
     exit(1);
   }
 
-  vstring prefix = vstring(argv[2])+" ";
-  ifstream inp(argv[3]);
+  SolverReplayer replayer(argv[2]);
+  SATSolverSCP solver;
+  if(argc==4 && vstring(argv[3])=="minisat") {
+    solver = new MinisatInterfacing(*env.options);
+  }
+  else {
+    solver = new TWLSolver(*env.options);
+  }
+
+  int startTime = env.timer->elapsedMilliseconds();
+  SATSolver::Status res = replayer.run(*solver);
+  int time = env.timer->elapsedMilliseconds()-startTime;
 
-  TWLSolver solver(*env.options, true);
-  Test::SolverReplayer replayer(solver);
-  replayer.runFromStream(inp, prefix);
+  cout << "status: " << (res==SATSolver::SATISFIABLE ? "sat" : res==SATSolver::UNSATISFIABLE ? "unsat" : "unknown") << endl;
+  cout << "solve calls: " << replayer.solveCalls() << endl;
+  cout << "status mismatches: " << replayer.statusMismatches() << endl;
+  cout << "time: " << time << " ms" << endl;
 
   return 0;
 }
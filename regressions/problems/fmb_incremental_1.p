@@ -0,0 +1,11 @@
+%the smallest model has three elements, the SAT solver of the size one
+%has to be extended to the larger sizes
+
+% params: -sa fmb --fmb_incremental on --statistics full
+% res: sat
+% grep: Incremental FMB rounds
+
+fof(a,axiom, ![X]: ~r(X,X)).
+fof(b,axiom, ![X,Y,Z]: ((r(X,Y) & r(Y,Z)) => r(X,Z))).
+fof(c,axiom, ![X]: ?[Y]: (r(X,Y) | r(Y,X))).
+fof(d,axiom, ?[X,Y,Z]: (r(X,Y) & r(Y,Z) & f(X)!=Z & f(f(Y))=X)).
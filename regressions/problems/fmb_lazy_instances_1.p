@@ -0,0 +1,11 @@
+%the smallest model has three elements, the instances violated by the
+%models found on the way have to be added lazily until one is found
+
+% params: -sa fmb --fmb_lazy_instances on --statistics full
+% res: sat
+% grep: Lazy FMB refinements
+
+fof(a,axiom, ![X]: ~r(X,X)).
+fof(b,axiom, ![X,Y,Z]: ((r(X,Y) & r(Y,Z)) => r(X,Z))).
+fof(c,axiom, ![X]: ?[Y]: (r(X,Y) | r(Y,X))).
+fof(d,axiom, ?[X,Y,Z]: (r(X,Y) & r(Y,Z) & f(X)!=Z & f(f(Y))=X)).
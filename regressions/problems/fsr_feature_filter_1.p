@@ -0,0 +1,11 @@
+%subsumption resolution must not be lost for clauses rejected
+%by the subsumption feature filter
+
+% params: -sff on
+% res: unsat
+% grep: subsumption resolution 2,1
+
+cnf(a,axiom, ~p(X) | q(f(f(X)))).
+cnf(b,axiom, p(a) | q(f(f(a))) | r).
+cnf(c,axiom, ~r).
+cnf(d,axiom, ~q(f(f(a)))).
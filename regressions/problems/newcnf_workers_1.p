@@ -0,0 +1,12 @@
+%clauses of formulas clausified by forked NewCNF workers,
+%including their skolem functions and names, must reach the parent
+
+% params: --newcnf on --newcnf_workers 3 -nm 2
+% res: unsat
+
+fof(a,axiom, ![X]: ?[Y]: (p(X,Y) & q(Y))).
+fof(b,axiom, ![X]: ((r(X) <=> s(X)) | (r(X) <=> ~s(X)) | t)).
+fof(c,axiom, ![X,Y]: (p(X,Y) => (s(Y) <=> (r(Y) <=> t)))).
+fof(d,axiom, ~t & ![X]: (q(X) => ~s(X))).
+fof(e,axiom, ![X]: (q(X) => ~r(X))).
+fof(f,axiom, ?[X]: r(X) | ![X]: (q(X) => ~r(X))).
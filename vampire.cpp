@@ -20,10 +20,13 @@
  * @file vampire.cpp. Implements the top-level procedures of Vampire.
  */
 
+#include <algorithm>
 #include <iostream>
 #include <ostream>
 #include <fstream>
 #include <csignal>
+#include <fcntl.h>
+#include <unistd.h>
 
 #if VZ3
 #include "z3++.h"
@@ -44,9 +47,11 @@
 #include "Lib/List.hpp"
 #include "Lib/Vector.hpp"
 #include "Lib/System.hpp"
+#include "Lib/StringUtils.hpp"
 #include "Lib/Metaiterators.hpp"
 
 #include "Lib/RCPtr.hpp"
+#include "Lib/Sys/Multiprocessing.hpp"
 
 
 #include "Kernel/Clause.hpp"
@@ -88,10 +93,12 @@
 
 #include "Saturation/SaturationAlgorithm.hpp"
 
+#include "SAT/BufferedSolver.hpp"
 #include "SAT/MinisatInterfacing.hpp"
 #include "SAT/MinisatInterfacingNewSimp.hpp"
 #include "SAT/TWLSolver.hpp"
 #include "SAT/Preprocess.hpp"
+#include "SAT/RecordingSolver.hpp"
 
 #include "FMB/ModelCheck.hpp"
 
@@ -517,25 +524,221 @@ void outputMode()
   vampireReturnValue = VAMP_RESULT_STATUS_SUCCESS;
 } // outputMode
 
-static SATClauseList* getInputClauses(const char* fname, unsigned& varCnt)
+/**
+ * Adds the clauses of a DIMACS input to a SAT solver as they are read.
+ *
+ * The solver does not take over the clauses, so they are kept to be
+ * destroyed together with the solver.
+ */
+class SolverClauseConsumer : public DIMACS::ClauseConsumer
+{
+public:
+  SolverClauseConsumer(SATSolver& solver) : _solver(solver), _varCnt(0) {}
+
+  ~SolverClauseConsumer()
+  {
+    while(_clauses.isNonEmpty()) {
+      _clauses.pop()->destroy();
+    }
+  }
+
+  virtual void onHeader(unsigned varCnt, unsigned clauseCnt)
+  {
+    ensureVarCount(varCnt);
+  }
+
+  virtual void onClause(SATClause* cl)
+  {
+    CALL("SolverClauseConsumer::onClause");
+
+    unsigned clen = cl->length();
+    for(unsigned i=0;i<clen;i++) {
+      ensureVarCount((*cl)[i].var());
+    }
+    cl = SAT::Preprocess::removeDuplicateLiterals(cl);
+    if(cl) {
+      _clauses.push(cl);
+      _solver.addClause(cl);
+    }
+  }
+
+private:
+  void ensureVarCount(unsigned varCnt)
+  {
+    if(varCnt>_varCnt) {
+      _varCnt = varCnt;
+      _solver.ensureVarCount(varCnt);
+    }
+  }
+
+  SATSolver& _solver;
+  unsigned _varCnt;
+  SATClauseStack _clauses;
+};
+
+static SATSolver* createSATSolver(vstring name)
 {
-  CALL("getInputClauses");
-  TimeCounter tc(TC_PARSING);
+  CALL("createSATSolver");
+
+  if(name=="vampire") {
+    return new TWLSolver(*env.options);
+  }
+  if(name=="minisat") {
+    return new MinisatInterfacing(*env.options);
+  }
+  if(name=="minisat_simp") {
+    return new MinisatInterfacingNewSimp(*env.options);
+  }
+  if(name=="buffered") {
+    return new BufferedSolver(new TWLSolver(*env.options));
+  }
+  USER_ERROR("Unknown SAT solver back end: "+name);
+}
 
-  return DIMACS::parse(fname, varCnt);
+static bool hasSuffix(const vstring& str, const vstring& suffix)
+{
+  return str.size()>=suffix.size() && str.compare(str.size()-suffix.size(), suffix.size(), suffix)==0;
 }
 
-static SATClauseIterator preprocessClauses(SATClauseList* clauses) {
-  CALL("preprocessClauses");
-  TimeCounter tc(TC_PREPROCESSING);
-  
-  return SAT::Preprocess::removeDuplicateLiterals(pvi(SATClauseList::DestructiveIterator(clauses)));
+static void outputJSONString(ostream& out, vstring str)
+{
+  out << '"';
+  for(unsigned i=0;i<str.size();i++) {
+    if(str[i]=='"' || str[i]=='\\') {
+      out << '\\';
+    }
+    out << str[i];
+  }
+  out << '"';
 }
 
+/**
+ * Run each of the SAT solver back ends listed in the sat_benchmark option
+ * on the input file, or on all *.cnf and *.trace files if the input is a
+ * directory, printing one JSON object per line for each run.
+ *
+ * The *.cnf files are DIMACS problems solved by a single solve call,
+ * the *.trace files are SAT call traces written with the sat_trace option,
+ * which are replayed call by call. For traces the parse time is the time
+ * of loading the trace and the status is that of the last solve call.
+ *
+ * Peak memory is the peak of the memory used by the allocator above the
+ * amount used when the run started. It is sampled every millisecond.
+ */
+void satBenchmarkMode()
+{
+  CALL("satBenchmarkMode()");
+
+  Stack<vstring> backEnds;
+  StringUtils::splitStr(env.options->satBenchmark().c_str(), ',', backEnds);
+
+  Stack<vstring> files;
+  vstring input = env.options->inputFile();
+  System::readDir(input, files);
+  if(files.isEmpty()) {
+    files.push(input);
+  }
+  else {
+    Stack<vstring>::StableDelIterator fit(files);
+    while(fit.hasNext()) {
+      vstring fname = fit.next();
+      if(!hasSuffix(fname, ".cnf") && !hasSuffix(fname, ".trace")) {
+        fit.del();
+      }
+    }
+    std::sort(files.begin(), files.end());
+  }
+
+  Stack<vstring>::BottomFirstIterator fit(files);
+  while(fit.hasNext()) {
+    vstring fname = fit.next();
+    Stack<vstring>::BottomFirstIterator bit(backEnds);
+    while(bit.hasNext()) {
+      vstring backEnd = bit.next();
+
+      unsigned long conflicts = env.statistics->satConflicts;
+      unsigned long propagations = env.statistics->satPropagations;
+      env.statistics->phase = Statistics::SAT_SOLVING;
+      size_t baseMemory = Allocator::getUsedMemory();
+      env.statistics->phasePeakMemory[Statistics::SAT_SOLVING] = baseMemory;
+      int startTime = env.timer->elapsedMilliseconds();
+
+      SATSolver::Status res;
+      int parseTime;
+      unsigned solveCalls = 1;
+      unsigned statusMismatches = 0;
+      if(hasSuffix(fname, ".trace")) {
+        // the replayer owns the clauses, so it must outlive the solver
+        SolverReplayer replayer(fname.c_str());
+        parseTime = env.timer->elapsedMilliseconds()-startTime;
+        SATSolverSCP solver(createSATSolver(backEnd));
+        if(replayer.usesAssumptions() && !dynamic_cast<SATSolverWithAssumptions*>(solver.ptr())) {
+          cout << "{\"file\": ";
+          outputJSONString(cout, fname);
+          cout << ", \"solver\": ";
+          outputJSONString(cout, backEnd);
+          cout << ", \"status\": \"unsupported\"}" << endl;
+          continue;
+        }
+        res = replayer.run(*solver);
+        solveCalls = replayer.solveCalls();
+        statusMismatches = replayer.statusMismatches();
+        env.statistics->samplePhase();
+      }
+      else {
+        SATSolverSCP solver(createSATSolver(backEnd));
+        SolverClauseConsumer consumer(*solver);
+        unsigned maxVar;
+        DIMACS::parse(fname.c_str(), consumer, maxVar);
+        parseTime = env.timer->elapsedMilliseconds()-startTime;
+        res = solver->solve();
+        env.statistics->samplePhase();
+      }
+      int solveTime = env.timer->elapsedMilliseconds()-startTime-parseTime;
+      conflicts = env.statistics->satConflicts-conflicts;
+      propagations = env.statistics->satPropagations-propagations;
+      double solveSeconds = max(solveTime, 1)/1000.0;
+
+      cout << "{\"file\": ";
+      outputJSONString(cout, fname);
+      cout << ", \"solver\": ";
+      outputJSONString(cout, backEnd);
+      cout << ", \"status\": \"";
+      switch(res) {
+      case SATSolver::SATISFIABLE:
+        cout << "sat";
+        break;
+      case SATSolver::UNSATISFIABLE:
+        cout << "unsat";
+        break;
+      default:
+        cout << "unknown";
+      }
+      cout << "\", \"parse_ms\": " << parseTime
+           << ", \"solve_ms\": " << solveTime
+           << ", \"solve_calls\": " << solveCalls
+           << ", \"status_mismatches\": " << statusMismatches
+           << ", \"conflicts\": " << conflicts
+           << ", \"propagations\": " << propagations
+           << ", \"conflicts_per_sec\": " << static_cast<unsigned long>(conflicts/solveSeconds)
+           << ", \"propagations_per_sec\": " << static_cast<unsigned long>(propagations/solveSeconds)
+           << ", \"peak_memory_kb\": " << (env.statistics->phasePeakMemory[Statistics::SAT_SOLVING]-baseMemory)/1024
+           << "}" << endl;
+    }
+  }
+  env.statistics->phase = Statistics::FINALIZATION;
+  vampireReturnValue = VAMP_RESULT_STATUS_SUCCESS;
+}
 
 void satSolverMode()
 {
   CALL("satSolverMode()");
+
+  if(env.options->satBenchmark()!="off") {
+    satBenchmarkMode();
+    return;
+  }
+
   TimeCounter tc(TC_SAT_SOLVER);
   SATSolverSCP solver;
   
@@ -550,16 +753,15 @@ void satSolverMode()
       ASSERTION_VIOLATION(env.options->satSolver());
   }
     
-  //get the clauses; 
-  SATClauseList* clauses;
-  unsigned varCnt=0;
-
   SATSolver::Status res; 
-  
-  clauses = getInputClauses(env.options->inputFile().c_str(), varCnt);
-  
-  solver->ensureVarCount(varCnt);
-  solver->addClausesIter(preprocessClauses(clauses));
+
+  //the clauses are added to the solver as they are parsed
+  SolverClauseConsumer consumer(*solver);
+  unsigned varCnt=0;
+  {
+    TimeCounter tc(TC_PARSING);
+    DIMACS::parse(env.options->inputFile().c_str(), consumer, varCnt);
+  }
 
   res = solver->solve();
 
@@ -806,6 +1008,140 @@ void groundingMode()
   }
 } // groundingMode
 
+/** The line terminating the problem of a job in the server mode */
+static const char* SERVER_PROBLEM_END = ".";
+
+/**
+ * If the options ask for help or an explanation of an option, output it and
+ * exit.
+ */
+static void outputHelpIfRequested()
+{
+  CALL("outputHelpIfRequested");
+
+  // If any of these options are set then we just need to output and exit
+  if (env.options->showHelp() ||
+      env.options->showOptions() ||
+      env.options->showExperimentalOptions() ||
+      !env.options->explainOption().empty() ||
+      env.options->printAllTheoryAxioms()) {
+    env.beginOutput();
+    env.options->output(env.out());
+    env.endOutput();
+    exit(0);
+  }
+} // outputHelpIfRequested
+
+/**
+ * Run the server mode. Jobs are read from the standard input, each of them
+ * is a line of options in the command line syntax, followed by the problem
+ * and a line containing a single '.', unless the options name a problem file.
+ * Options given to the server itself serve as defaults for the jobs.
+ *
+ * Every job runs in a worker process forked from the server. The server
+ * itself never parses or proves anything, so the workers start with the same
+ * clean signature, term sharing and statistics as a new process would, but
+ * without the cost of starting one. The state shared by all jobs, that is the
+ * option tables, the sorts, the theory and the signature with its built-in
+ * symbols, is set up before the first job and inherited by the workers.
+ * Symbols and theory axioms of particular problems are not added in advance,
+ * since the numbers of symbols determine their precedence and jobs must behave
+ * as they would in a process of their own. When a worker terminates, the
+ * server outputs the line "%%% done <exit status>".
+ *
+ * Only the workers return from this function, with env.options set to the
+ * options of their job and the problem given in the job, if any, readable
+ * from cin. The server returns at the end of its input.
+ */
+void serverMode()
+{
+  CALL("serverMode()");
+
+  // the server waits for jobs as long as needed, time limits only apply to the workers
+  Timer::setTimeLimitEnforcement(false);
+
+  unsigned jobCnt = 0;
+  vstring line;
+  while (getline(cin, line)) {
+    Stack<vstring> args;
+    vistringstream words(line);
+    vstring word;
+    while (words >> word) {
+      args.push(word);
+    }
+    if (args.isEmpty()) {
+      continue;
+    }
+
+    // as in CommandLine::interpret, an argument that is neither an option nor its value is a file name
+    bool fileGiven = false;
+    for (unsigned i = 0; i < args.size(); i++) {
+      if (args[i][0] == '-') {
+        i++;
+      } else {
+        fileGiven = true;
+      }
+    }
+
+    vstring problem;
+    if (!fileGiven) {
+      while (getline(cin, line) && line != SERVER_PROBLEM_END) {
+        problem += line;
+        problem += '\n';
+      }
+    }
+
+    jobCnt++;
+    pid_t worker = Multiprocessing::instance()->fork();
+    if (!worker) {
+      // the worker must not touch the server's input: when the input is a file, the clean-up
+      // of stdin at exit would move the shared file offset back to where the worker was forked
+      int devNull = open("/dev/null", O_RDONLY);
+      dup2(devNull, 0);
+      close(devNull);
+
+      System::registerForSIGHUPOnParentDeath();
+      env.timer->reset();
+      env.timer->start();
+      TimeCounter::reinitialize();
+      Timer::setTimeLimitEnforcement(true);
+
+      // jobs run in the vampire mode unless they ask for another one
+      env.options->setMode(Options::Mode::VAMPIRE);
+      env.options->setInputFile("");
+
+      // CommandLine skips the first argument, which is normally the name of the executable
+      Stack<char*> argv;
+      argv.push(const_cast<char*>("vampire"));
+      for (unsigned i = 0; i < args.size(); i++) {
+        argv.push(const_cast<char*>(args[i].c_str()));
+      }
+      Shell::CommandLine cl(argv.size(), argv.begin());
+      cl.interpret(*env.options);
+      outputHelpIfRequested();
+
+      if (env.options->mode() == Options::Mode::SERVER) {
+        USER_ERROR("A server job cannot run another server");
+      }
+      if (!fileGiven) {
+        env.options->setProblemName("job" + Int::toString(jobCnt));
+        // the stream is never deleted, the worker terminates after the job
+        vistringstream* input = new vistringstream(problem);
+        cin.rdbuf(input->rdbuf());
+      }
+      return;
+    }
+
+    int exitStatus;
+    Multiprocessing::instance()->waitForChildTermination(exitStatus);
+
+    env.beginOutput();
+    env.out() << "%%% done " << exitStatus << endl;
+    env.endOutput();
+  }
+  vampireReturnValue = VAMP_RESULT_STATUS_SUCCESS;
+} // serverMode
+
 /**
  * The main function.
  * @since 03/12/2003 many changes related to logging
@@ -828,17 +1164,11 @@ int main(int argc, char* argv[])
     // read the command line and interpret it
     Shell::CommandLine cl(argc, argv);
     cl.interpret(*env.options);
+    outputHelpIfRequested();
 
-    // If any of these options are set then we just need to output and exit
-    if (env.options->showHelp() ||
-        env.options->showOptions() ||
-        env.options->showExperimentalOptions() ||
-        !env.options->explainOption().empty() ||
-        env.options->printAllTheoryAxioms()) {
-      env.beginOutput();
-      env.options->output(env.out());
-      env.endOutput();
-      exit(0);
+    if (env.options->mode() == Options::Mode::SERVER) {
+      // the workers return from here with the options of their job
+      serverMode();
     }
 
     Allocator::setMemoryLimit(env.options->memoryLimit() * 1048576ul);
@@ -975,6 +1305,10 @@ int main(int argc, char* argv[])
       satSolverMode();
       break;
 
+    case Options::Mode::SERVER:
+      // only the server itself gets here, after it has processed all its jobs
+      break;
+
     default:
       USER_ERROR("Unsupported mode");
     }
@@ -0,0 +1,2 @@
+//Automatically generated file, see Makefile for details
+const char* VERSION_STRING = "Vampire 4.2.2 (commit 7a71706 on 2026-10-18 22:00:05 +0000)";